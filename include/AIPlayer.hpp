@@ -3,7 +3,20 @@
 #include "Types.hpp"
 #include "Board.hpp"
 #include "ChessLogic.hpp"
+#include "TranspositionTable.hpp"
+#include "OpeningBook.hpp"
+#include "Tablebase.hpp"
+#include "MoveList.hpp"
+#include "SearchStats.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
 #include <random>
+#include <string>
 #include <vector>
 
 namespace Chess {
@@ -13,36 +26,209 @@ enum class AIDifficulty {
     Easy = 1,
     Medium = 2,
     Hard = 3,
-    Expert = 4
+    Expert = 4,
+    Master = 5
+};
+
+// Réductions et élagages de la recherche sélective, activables un par un pour comparer
+struct SearchFeatures {
+    bool nullMove = true;            // coup nul : passer son tour et couper si l'on tient encore beta
+    bool lateMoveReductions = true;  // coups calmes tardifs cherchés moins profond, revus s'ils montent
+    bool futility = true;            // coups calmes écartés près des feuilles quand l'éval est trop basse
 };
 
 class AIPlayer {
 public:
     AIPlayer(Board& board, ChessLogic& logic);
+    ~AIPlayer();
     
-    // Trouve le meilleur coup pour la couleur donnée
+    // Trouve le meilleur coup pour la couleur donnée (bloquant)
+    // Approfondissement itératif jusqu'à getMaxDepth(), borné par le budget de temps
     Move findBestMove(Color color);
     
+    // Recherche asynchrone : le board est copié au démarrage, la recherche tourne
+    // sur un thread et peut être interrompue (le meilleur coup complet est alors rendu)
+    void startSearch(Color color);
+    bool isSearching() const { return m_searchFuture.valid(); }
+    bool isSearchDone() const;
+    Move getSearchResult();
+    void cancelSearch();
+    // Demande l'arrêt sans attendre : le meilleur coup reste à lire par getSearchResult
+    // (utilisable depuis un autre thread que celui qui attend le résultat)
+    void stopSearch();
+    
+    // Réflexion sur le temps de l'adversaire : recherche sans limite de temps la réponse
+    // à expectedReply, le coup adverse prévu. ponderHit donne le coup vraiment joué :
+    // s'il était prévu la recherche continue avec le budget normal (résultat par
+    // getSearchResult), sinon elle est abandonnée en gardant la table de transposition
+    void startPondering(Color color, const Move& expectedReply);
+    bool isPondering() const { return m_pondering; }
+    bool ponderHit(const Move& played);
+    
+    // Variante UCI (go ponder / ponderhit) : le coup prévu est déjà joué sur la position
+    // et l'interface ne confirme que la réussite, le budget démarre alors
+    void startPondering(Color color);
+    void ponderHit();
+    
+    // Réponse adverse attendue après le dernier coup (nul si la variation est trop courte)
+    Move getExpectedReply() const { return m_stats.pv.size() >= 2 ? m_stats.pv[1] : Move{}; }
+    
+    // Budget de temps : durée fixe par coup, ou dérivée du temps restant à la pendule
+    // (0 = pas de limite, la recherche va jusqu'à la profondeur maximale)
+    void setMoveTime(int milliseconds) { m_moveTimeMs = milliseconds; }
+    void setRemainingTime(int milliseconds) { m_remainingTimeMs = milliseconds; }
+    
     // Définit le niveau de difficulté
     void setDifficulty(AIDifficulty difficulty) { m_difficulty = difficulty; }
     AIDifficulty getDifficulty() const { return m_difficulty; }
+    
+    // Profondeur maximale imposée, à la place de celle du niveau (0 = selon le niveau)
+    void setDepthLimit(int depth) { m_depthLimit = depth; }
+    
+    // Recherche sélective (tout est activé par défaut)
+    void setSearchFeatures(const SearchFeatures& features) { m_features = features; }
+    const SearchFeatures& getSearchFeatures() const { return m_features; }
+    
+    // Sans hasard : premier des meilleurs coups à égalité et coup le plus lourd du livre
+    // (bench et comparaisons reproductibles ; avec un seul thread et une table vidée,
+    // la même position donne alors toujours la même recherche)
+    void setDeterministic(bool deterministic) { m_deterministic = deterministic; }
+    bool isDeterministic() const { return m_deterministic; }
+    
+    // Nombre de threads de recherche (Lazy SMP : les threads auxiliaires partagent la table)
+    void setThreadCount(int threads);
+    int getThreadCount() const { return static_cast<int>(m_threads.size()); }
+    
+    // Taille de la table de transposition en Mo
+    void setHashSize(std::size_t megabytes) { m_tt.resize(megabytes); }
+    void clearHash() { m_tt.clear(); }
+    
+    // Livre d'ouvertures consulté avant chaque recherche (false si le fichier est illisible)
+    bool loadOpeningBook(const std::string& path) { return m_book.open(path); }
+    bool hasOpeningBook() const { return m_book.isOpen(); }
+    
+    // Tables de finales Syzygy (état global) et nombre de pièces à partir duquel on les
+    // sonde, à la racine comme dans l'arbre (0 = jamais)
+    bool loadTablebases(const std::string& path) { return Tablebase::init(path); }
+    void setTablebasePieceLimit(int pieces) { m_tbPieceLimit = pieces; }
+    int getTablebasePieceLimit() const { return m_tbPieceLimit; }
+    
+    // Statistiques de la dernière recherche terminée (à lire une fois le résultat récupéré)
+    const SearchStats& getLastSearchStats() const { return m_stats; }
+    
+    // Appelé par le thread de recherche après chaque itération complète, avec sa
+    // variation principale (à définir avant de lancer la recherche)
+    using IterationCallback = std::function<void(const IterationStats&, const std::vector<Move>&)>;
+    void setIterationCallback(IterationCallback callback) { m_onIteration = std::move(callback); }
+    
+    // Compte les feuilles à la profondeur donnée avec le générateur de la recherche
+    // (outil perft : vérifie la légalité et mesure la vitesse de génération)
+    std::uint64_t perft(Board& board, int depth) const;
+    
+    static constexpr int INFINITY_SCORE = 1000000;
+    static constexpr int MATE_SCORE = 100000;
+    static constexpr int MAX_PLY = 64;
+    // Gain connu des tables : sous les scores de mat, qui restent prioritaires
+    static constexpr int TB_WIN_SCORE = MATE_SCORE - 2 * MAX_PLY;
 
 private:
-    // Simule un coup sur une copie du board (retourne le nouveau board + nouveau tour)
-    bool simulateMove(Board& board, const Move& move, Color currentTurn) const;
+    // Position sur la pile des répétitions : clé et compteur des 50 coups
+    struct KeyEntry {
+        std::uint64_t hash;
+        int halfmoveClock;
+    };
+    
+    // État propre à chaque thread de recherche : sa copie du board et sa variation principale
+    struct SearchThread {
+        Board board;
+        // Positions depuis le dernier coup irréversible de la partie puis de la recherche,
+        // la dernière étant la position courante
+        std::vector<KeyEntry> keys;
+        // Lu par le thread principal en cours de recherche (compte de chaque itération) ;
+        // seul le thread propriétaire l'incrémente, sans instruction atomique
+        std::atomic<std::uint64_t> nodes{0};
+        std::uint64_t qnodes = 0;
+        std::uint64_t cutoffs = 0;
+        std::uint64_t firstMoveCutoffs = 0;
+        std::uint64_t ttProbes = 0;
+        std::uint64_t ttHits = 0;
+        std::uint64_t tbHits = 0;
+        std::array<std::array<PackedMove, MAX_PLY>, MAX_PLY> pvTable;
+        std::array<int, MAX_PLY> pvLength{};
+        std::vector<PackedMove> previousPv;
+        // Deux coups meurtriers par ply et historique [couleur][départ][arrivée]
+        std::array<std::array<PackedMove, 2>, MAX_PLY> killers;
+        std::array<std::array<std::array<int, 64>, 64>, 2> history;
+        bool followPv = false;
+        bool isMain = false;
+        
+        std::uint64_t countNode() {
+            std::uint64_t count = nodes.load(std::memory_order_relaxed) + 1;
+            nodes.store(count, std::memory_order_relaxed);
+            return count;
+        }
+    };
+    
+    // Nœuds cherchés jusqu'ici par tous les threads
+    std::uint64_t searchedNodes() const;
     
     // Génère tous les coups légaux pour une couleur sur un board donné
-    std::vector<Move> generateMoves(const Board& board, Color color) const;
+    // (légalité vérifiée par les clouages et les échecs, sans jouer les coups)
+    // tacticalOnly : seulement les prises et les promotions (quiescence)
+    void generateMoves(Board& board, Color color, PackedMoveList& moves, bool tacticalOnly = false) const;
     
-    // Vérifie si une position est attaquée
-    bool isAttacked(const Board& board, const Position& pos, Color byColor) const;
+    // Versions spécialisées par couleur (sens des pions et cases fixés à la compilation),
+    // utilisées dans l'arbre où le camp au trait alterne à chaque ply
+    template <Color Us>
+    void generateMoves(Board& board, PackedMoveList& moves, bool tacticalOnly = false) const;
     
     // Vérifie si le roi d'une couleur est en échec
-    bool isInCheck(const Board& board, Color color) const;
+    template <Color Us>
+    bool isInCheck(const Board& board) const;
     
-    // Minimax sur des copies du board (JAMAIS de modification du board réel)
-    int minimax(Board board, Color currentTurn, int depth, int alpha, int beta,
-                bool maximizing, Color aiColor);
+    // Copie le board réel et prépare une nouvelle recherche (thread appelant)
+    void prepareSearch(Color color);
+    
+    // Approfondissement itératif sur le thread principal (peut tourner sur un autre thread)
+    Move runSearch();
+    
+    // Additionne les compteurs des threads dans m_stats à la fin de la recherche
+    void collectStats();
+    
+    // Boucle d'un thread auxiliaire : mêmes itérations, décalées d'un ply une fois sur deux
+    void helperSearch(SearchThread& thread, PackedMoveList moves, int index);
+    
+    // Recherche à la racine pour une itération ; remplit bestMoves avec les coups ex-aequo
+    int searchRoot(SearchThread& thread, PackedMoveList& moves, int depth, PackedMoveList& bestMoves);
+    
+    // Minimax (negamax) en place sur le board de recherche (make/unmake, jamais le board réel)
+    // Score du point de vue du joueur au trait (Us), ply = distance à la racine
+    // allowNull : faux juste après un coup nul, pour ne pas en enchaîner deux
+    template <Color Us>
+    int minimax(SearchThread& thread, int depth, int ply, int alpha, int beta, bool allowNull = true);
+    
+    // Joue et annule un coup (ou un coup nul) sur le board du thread en tenant sa pile de clés
+    MoveRecord playMove(SearchThread& thread, PackedMove move) const;
+    void takeBack(SearchThread& thread, const MoveRecord& record) const;
+    MoveRecord playNullMove(SearchThread& thread) const;
+    void takeBackNullMove(SearchThread& thread, const MoveRecord& record) const;
+    
+    // Nulle par répétition ou par la règle des 50 coups à la position courante du thread
+    bool isDraw(const SearchThread& thread) const;
+    
+    // Prolonge les feuilles par les prises jusqu'à une position calme
+    template <Color Us>
+    int quiescence(SearchThread& thread, int ply, int alpha, int beta);
+    
+    // Bilan matériel de la suite de prises sur la case d'arrivée (SEE), pour le camp qui joue
+    int staticExchange(const Board& board, PackedMove move) const;
+    
+    // Note chaque coup une fois pour toutes avant la boucle (sélection ensuite par pickMove)
+    void scoreMoves(const SearchThread& thread, const Board& board, const PackedMoveList& moves,
+                    int* scores, PackedMove ttMove, PackedMove pvMove, int ply) const;
+    
+    // Coups meurtriers et historique après une coupure par un coup calme
+    void updateQuietCutoff(SearchThread& thread, const Board& board, PackedMove move, int depth, int ply);
     
     // Évaluation statique
     int evaluateBoard(const Board& board, Color aiColor) const;
@@ -50,24 +236,56 @@ private:
     // Profondeur maximale selon la difficulté
     int getMaxDepth() const;
     
+    // Budget de temps en ms pour le coup à jouer (0 = illimité)
+    int computeTimeBudget() const;
+    
+    // Vérifie périodiquement le temps écoulé et lève m_stopSearch
+    void checkTime();
+    int elapsedMs() const;
+    
+    // Temps décompté sur le budget : depuis le ponderHit quand on a réfléchi avant
+    int clockMs() const { return elapsedMs() - m_clockStartMs; }
+    
+    // Coup de la variation principale précédente à ce ply si on la suit encore (sinon nul)
+    PackedMove followPvMove(SearchThread& thread, const PackedMoveList& moves, int ply);
+    
+    // Coup du livre parmi les coups de la racine, tiré selon les poids (nul hors livre)
+    PackedMove probeBook(const Board& board, const PackedMoveList& moves);
+    
+    // Coup des tables de finales parmi les coups de la racine (nul si la position n'y est pas)
+    PackedMove probeTablebaseRoot(const Board& board, int halfmoveClock, const PackedMoveList& moves,
+                                  int& score) const;
+    
     // Valeur des pièces
     int getPieceValue(PieceType type) const;
-    
-    // Bonus de position
-    int getPositionBonus(const Position& pos, PieceType type, Color color) const;
 
     Board& m_board;
     ChessLogic& m_logic;
     AIDifficulty m_difficulty;
+    int m_depthLimit;
+    SearchFeatures m_features;
     std::mt19937 m_rng;
+    bool m_deterministic;
+    TranspositionTable m_tt;
+    OpeningBook m_book;
+    int m_tbPieceLimit;
+    
+    // Gestion du temps
+    int m_moveTimeMs;
+    int m_remainingTimeMs;
+    std::atomic<int> m_timeBudgetMs;
+    std::chrono::steady_clock::time_point m_searchStart;
+    std::atomic<int> m_clockStartMs;
+    std::atomic<bool> m_stopSearch;
+    std::atomic<bool> m_pondering;
+    Move m_ponderMove;
     
-    // Tables de bonus de position
-    static const int PAWN_TABLE[8][8];
-    static const int KNIGHT_TABLE[8][8];
-    static const int BISHOP_TABLE[8][8];
-    static const int ROOK_TABLE[8][8];
-    static const int QUEEN_TABLE[8][8];
-    static const int KING_TABLE[8][8];
+    // Threads de recherche (le premier est le thread principal) et recherche en cours
+    std::vector<std::unique_ptr<SearchThread>> m_threads;
+    Color m_rootColor;
+    std::future<Move> m_searchFuture;
+    SearchStats m_stats;
+    IterationCallback m_onIteration;
 };
 
 } // namespace Chess
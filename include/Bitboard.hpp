@@ -0,0 +1,202 @@
+#pragma once
+
+#include "Types.hpp"
+#include <array>
+#include <cstdint>
+
+namespace Chess {
+
+// One bit per square, square index = row * 8 + col (row 0 = rank 8, as in Position)
+using Bitboard = std::uint64_t;
+
+constexpr int squareIndex(int row, int col) { return row * 8 + col; }
+constexpr int squareIndex(const Position& pos) { return pos.row * 8 + pos.col; }
+inline Position squarePosition(int sq) { return {sq >> 3, sq & 7}; }
+constexpr Bitboard squareBit(int sq) { return Bitboard(1) << sq; }
+
+inline int popCount(Bitboard b) { return __builtin_popcountll(b); }
+inline int lsb(Bitboard b) { return __builtin_ctzll(b); }
+inline int msb(Bitboard b) { return 63 - __builtin_clzll(b); }
+inline int popLsb(Bitboard& b) {
+    int sq = lsb(b);
+    b &= b - 1;
+    return sq;
+}
+
+constexpr int colorIndex(Color color) { return color == Color::White ? 0 : 1; }
+constexpr int typeIndex(PieceType type) { return static_cast<int>(type); }
+constexpr Color opponentOf(Color color) { return color == Color::White ? Color::Black : Color::White; }
+
+constexpr Bitboard rowBits(int row) { return Bitboard(0xFF) << (row * 8); }
+inline constexpr Bitboard FILE_A = 0x0101010101010101ULL;
+inline constexpr Bitboard FILE_H = FILE_A << 7;
+
+// Moves every bit by delta squares (towards higher indices when positive)
+template <int Delta>
+constexpr Bitboard shift(Bitboard b) { return Delta > 0 ? b << Delta : b >> -Delta; }
+
+// Colour-dependent constants fixed at compile time, so that code templated on the
+// side to move has no colour branches left in its inner loops
+template <Color Us>
+struct Side {
+    static_assert(Us == Color::White || Us == Color::Black, "Side needs White or Black");
+    
+    static constexpr Color THEM = opponentOf(Us);
+    static constexpr int INDEX = colorIndex(Us);
+    // Square offset of a pawn push: White moves towards row 0
+    static constexpr int PUSH = Us == Color::White ? -8 : 8;
+    static constexpr Bitboard PROMOTION_RANK = rowBits(Us == Color::White ? 0 : 7);
+    // Rank reached by a single push from the start rank, where a double push may go on
+    static constexpr Bitboard DOUBLE_PUSH_RANK = rowBits(Us == Color::White ? 5 : 2);
+    
+    // Castling: king start square, squares that must be empty and squares the king crosses
+    static constexpr int HOME_ROW = Us == Color::White ? 7 : 0;
+    static constexpr int KING_START = HOME_ROW * 8 + 4;
+    static constexpr Bitboard KINGSIDE_EMPTY = Bitboard(0x60) << (HOME_ROW * 8);
+    static constexpr Bitboard QUEENSIDE_EMPTY = Bitboard(0x0E) << (HOME_ROW * 8);
+    static constexpr int KINGSIDE_PATH[2] = {KING_START + 1, KING_START + 2};
+    static constexpr int QUEENSIDE_PATH[2] = {KING_START - 1, KING_START - 2};
+};
+
+namespace Attacks {
+
+namespace detail {
+
+constexpr Bitboard leaperAttacks(int sq, const int (&offsets)[8][2]) {
+    Bitboard attacks = 0;
+    int row = sq >> 3;
+    int col = sq & 7;
+    for (const auto& o : offsets) {
+        int r = row + o[0];
+        int c = col + o[1];
+        if (r >= 0 && r < 8 && c >= 0 && c < 8) {
+            attacks |= Bitboard(1) << (r * 8 + c);
+        }
+    }
+    return attacks;
+}
+
+constexpr std::array<Bitboard, 64> makeKnightTable() {
+    const int offsets[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
+                               {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+    std::array<Bitboard, 64> table{};
+    for (int sq = 0; sq < 64; ++sq) table[sq] = leaperAttacks(sq, offsets);
+    return table;
+}
+
+constexpr std::array<Bitboard, 64> makeKingTable() {
+    const int offsets[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1},
+                               {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+    std::array<Bitboard, 64> table{};
+    for (int sq = 0; sq < 64; ++sq) table[sq] = leaperAttacks(sq, offsets);
+    return table;
+}
+
+// White pawns move towards row 0, black pawns towards row 7
+constexpr std::array<std::array<Bitboard, 64>, 2> makePawnTable() {
+    std::array<std::array<Bitboard, 64>, 2> table{};
+    for (int sq = 0; sq < 64; ++sq) {
+        int row = sq >> 3;
+        int col = sq & 7;
+        for (int side = 0; side < 2; ++side) {
+            int r = row + (side == 0 ? -1 : 1);
+            if (r < 0 || r > 7) continue;
+            if (col > 0) table[side][sq] |= Bitboard(1) << (r * 8 + col - 1);
+            if (col < 7) table[side][sq] |= Bitboard(1) << (r * 8 + col + 1);
+        }
+    }
+    return table;
+}
+
+// Ray directions as {row step, col step}; the first four increase the square index
+inline constexpr int DIRECTIONS[8][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1},
+                                         {-1, 0}, {0, -1}, {-1, -1}, {-1, 1}};
+
+// Squares from sq to the edge of the board in each direction, sq excluded
+constexpr std::array<std::array<Bitboard, 64>, 8> makeRayTable() {
+    std::array<std::array<Bitboard, 64>, 8> table{};
+    for (int dir = 0; dir < 8; ++dir) {
+        for (int sq = 0; sq < 64; ++sq) {
+            int r = (sq >> 3) + DIRECTIONS[dir][0];
+            int c = (sq & 7) + DIRECTIONS[dir][1];
+            while (r >= 0 && r < 8 && c >= 0 && c < 8) {
+                table[dir][sq] |= Bitboard(1) << (r * 8 + c);
+                r += DIRECTIONS[dir][0];
+                c += DIRECTIONS[dir][1];
+            }
+        }
+    }
+    return table;
+}
+
+using SquarePairTable = std::array<std::array<Bitboard, 64>, 64>;
+
+// between: squares strictly between two aligned squares; line: the whole line through them
+constexpr SquarePairTable makeBetweenTable(bool wholeLine) {
+    SquarePairTable table{};
+    std::array<std::array<Bitboard, 64>, 8> rays = makeRayTable();
+    for (int from = 0; from < 64; ++from) {
+        for (int dir = 0; dir < 8; ++dir) {
+            int opposite = (dir + 4) % 8;
+            Bitboard ray = rays[dir][from];
+            Bitboard walked = 0;
+            int r = (from >> 3) + DIRECTIONS[dir][0];
+            int c = (from & 7) + DIRECTIONS[dir][1];
+            while (r >= 0 && r < 8 && c >= 0 && c < 8) {
+                int to = r * 8 + c;
+                table[from][to] = wholeLine ? (ray | rays[opposite][from] | (Bitboard(1) << from)) : walked;
+                walked |= Bitboard(1) << to;
+                r += DIRECTIONS[dir][0];
+                c += DIRECTIONS[dir][1];
+            }
+        }
+    }
+    return table;
+}
+
+} // namespace detail
+
+inline constexpr std::array<std::array<Bitboard, 64>, 8> RAYS = detail::makeRayTable();
+inline constexpr detail::SquarePairTable BETWEEN = detail::makeBetweenTable(false);
+inline constexpr detail::SquarePairTable LINE = detail::makeBetweenTable(true);
+
+inline constexpr std::array<Bitboard, 64> KNIGHT = detail::makeKnightTable();
+inline constexpr std::array<Bitboard, 64> KING = detail::makeKingTable();
+inline constexpr std::array<std::array<Bitboard, 64>, 2> PAWN = detail::makePawnTable();
+
+inline Bitboard knight(int sq) { return KNIGHT[sq]; }
+inline Bitboard king(int sq) { return KING[sq]; }
+// Squares attacked by a pawn of the given colour standing on sq
+inline Bitboard pawn(Color color, int sq) { return PAWN[colorIndex(color)][sq]; }
+
+// Attacks along one ray, stopping on (and including) the first occupied square:
+// the nearest blocker is the lowest bit on increasing rays and the highest otherwise
+inline Bitboard ray(int dir, int sq, Bitboard occupied) {
+    Bitboard attacks = RAYS[dir][sq];
+    Bitboard blockers = attacks & occupied;
+    if (blockers) {
+        int blocker = dir < 4 ? lsb(blockers) : msb(blockers);
+        attacks ^= RAYS[dir][blocker];
+    }
+    return attacks;
+}
+
+inline Bitboard bishop(int sq, Bitboard occupied) {
+    return ray(2, sq, occupied) | ray(3, sq, occupied) | ray(6, sq, occupied) | ray(7, sq, occupied);
+}
+
+inline Bitboard rook(int sq, Bitboard occupied) {
+    return ray(0, sq, occupied) | ray(1, sq, occupied) | ray(4, sq, occupied) | ray(5, sq, occupied);
+}
+
+inline Bitboard queen(int sq, Bitboard occupied) {
+    return bishop(sq, occupied) | rook(sq, occupied);
+}
+
+// Squares between a and b when they share a line (empty otherwise), and the full line
+inline Bitboard between(int a, int b) { return BETWEEN[a][b]; }
+inline Bitboard line(int a, int b) { return LINE[a][b]; }
+
+} // namespace Attacks
+
+} // namespace Chess
@@ -2,11 +2,34 @@
 
 #include "Types.hpp"
 #include "Piece.hpp"
+#include "Bitboard.hpp"
+#include "PackedMove.hpp"
+#include <cstdint>
 #include <array>
+#include <string>
 #include <vector>
 
 namespace Chess {
 
+// Everything needed to take back a move applied with Board::applyMove
+struct MoveRecord {
+    PackedMove move;
+    Piece capturedPiece;
+    Piece movedPiece;
+    Position enPassantTarget;
+    std::uint8_t castlingRights;
+    bool wasEnPassantCapture;
+    Position enPassantCapturePos;
+};
+
+// Checks and pins against one king, computed once per position so that most
+// pseudo-legal moves can be validated without playing them
+struct LegalityInfo {
+    int kingSq = -1;
+    Bitboard checkers = 0;
+    Bitboard pinned = 0;
+};
+
 class Board {
 public:
     Board();
@@ -14,36 +37,108 @@ public:
     void initialize();
     void clear();
     
+    // Set up a position from a FEN string (move counters are ignored).
+    // Returns false on malformed input, leaving the board in an unspecified state.
+    bool loadFEN(const std::string& fen);
+    
+    // FEN of the current position; the board keeps no move counters, so the
+    // caller provides them (ChessLogic::toFEN passes its own)
+    std::string toFEN(int halfmoveClock = 0, int fullmoveNumber = 1) const;
+    
+    // Mutable access is only meant for the moved flag: changing the type or
+    // colour of a square must go through setPiece/removePiece/movePiece so
+    // that the bitboards stay in sync.
     Piece& getPiece(const Position& pos);
     const Piece& getPiece(const Position& pos) const;
     Piece& getPiece(int row, int col);
     const Piece& getPiece(int row, int col) const;
+    const Piece& getPiece(int sq) const { return m_squares[sq]; }
     
     void setPiece(const Position& pos, const Piece& piece);
     void movePiece(const Position& from, const Position& to);
     void removePiece(const Position& pos);
     
+    // Play a move in place (no legality check) and take it back
+    MoveRecord applyMove(PackedMove move);
+    MoveRecord applyMove(const Move& move) { return applyMove(PackedMove::fromMove(move)); }
+    void revertMove(const MoveRecord& record);
+    
+    // Pass the turn (null-move pruning): only the side to move and the en passant
+    // target change, so the record just keeps the latter
+    MoveRecord applyNullMove();
+    void revertNullMove(const MoveRecord& record);
+    
     Position findKing(Color color) const;
     std::vector<Position> findPieces(Color color) const;
     
+    // Bitboards, kept in sync with the 64-square mailbox
+    Bitboard getPieces(Color color, PieceType type) const {
+        return m_pieceBB[colorIndex(color)][bitboardIndex(type)];
+    }
+    Bitboard getPieces(Color color) const { return m_colorBB[colorIndex(color)]; }
+    Bitboard getOccupied() const { return m_colorBB[0] | m_colorBB[1]; }
+    
+    // Attack queries on the bitboards; the templated forms are specialized per colour
+    // (instantiated for White and Black only) and the others dispatch to them
+    template <Color ByColor>
+    Bitboard attackersTo(int sq, Bitboard occupied) const;
+    Bitboard attackersTo(int sq, Color byColor, Bitboard occupied) const;
+    bool isAttacked(const Position& pos, Color byColor) const;
+    
+    // Legality of a pseudo-legal move for the side owning the moved piece
+    template <Color Us>
+    LegalityInfo legalityInfo() const;
+    LegalityInfo legalityInfo(Color color) const;
+    template <Color Us>
+    bool isLegal(PackedMove move, const LegalityInfo& info) const;
+    bool isLegal(PackedMove move, const LegalityInfo& info) const;
+    
+    // Side to move, flipped by applyMove/revertMove
+    Color getSideToMove() const { return m_sideToMove; }
+    void setSideToMove(Color color);
+    
+    // Zobrist key, updated incrementally by every mutator
+    std::uint64_t getHash() const { return m_hash; }
+    std::uint64_t computeHash() const;
+    
+    // Material plus piece-square score, White minus Black, updated with the bitboards
+    int getEvaluation() const { return m_evaluation; }
+    int computeEvaluation() const;
+    
     // En passant tracking
     Position getEnPassantTarget() const { return m_enPassantTarget; }
-    void setEnPassantTarget(const Position& pos) { m_enPassantTarget = pos; }
-    void clearEnPassantTarget() { m_enPassantTarget = {-1, -1}; }
+    void setEnPassantTarget(const Position& pos);
+    void clearEnPassantTarget();
     
-    // Castling rights
+    // Castling rights, as a mask: bit 0 white kingside, 1 white queenside,
+    // 2 black kingside, 3 black queenside
+    static constexpr std::uint8_t ALL_CASTLING = 0xF;
     bool canCastleKingside(Color color) const;
     bool canCastleQueenside(Color color) const;
     void disableCastling(Color color, bool kingside);
-    std::array<bool, 4> getCastlingRights() const { return m_castlingRights; }
-    void setCastlingRights(const std::array<bool, 4>& rights) { m_castlingRights = rights; }
+    std::uint8_t getCastlingRights() const { return m_castlingRights; }
+    void setCastlingRights(std::uint8_t rights);
 
 private:
-    std::array<std::array<Piece, 8>, 8> m_board;
+    // Mailbox indexed like the bitboards (row * 8 + col), one byte per square
+    std::array<Piece, 64> m_squares;
+    
+    // [colour][piece type - Pawn] (no slot for PieceType::None) and per-colour occupancy
+    std::array<std::array<Bitboard, 6>, 2> m_pieceBB;
+    std::array<Bitboard, 2> m_colorBB;
     Position m_enPassantTarget;
     
-    // Castling rights: [white kingside, white queenside, black kingside, black queenside]
-    std::array<bool, 4> m_castlingRights;
+    std::uint8_t m_castlingRights;
+    Color m_sideToMove;
+    std::uint64_t m_hash;
+    // En passant key currently folded into m_hash (0 when no capture is possible)
+    std::uint64_t m_enPassantKey;
+    int m_evaluation;
+    
+    static constexpr int bitboardIndex(PieceType type) { return typeIndex(type) - typeIndex(PieceType::Pawn); }
+    std::uint64_t enPassantKey(const Position& target) const;
+    void addToBitboards(int sq, const Piece& piece);
+    void removeFromBitboards(int sq, const Piece& piece);
 };
 
 } // namespace Chess
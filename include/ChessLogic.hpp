@@ -2,27 +2,30 @@
 
 #include "Types.hpp"
 #include "Board.hpp"
+#include "MoveList.hpp"
 #include <vector>
 #include <array>
+#include <string>
+#include <cstdint>
 
 namespace Chess {
 
-// Structure pour stocker toutes les informations nécessaires à l'annulation d'un coup
-struct MoveRecord {
-    Move move;
-    Piece capturedPiece;
-    Piece movedPiece;
-    Position enPassantTarget;
-    std::array<bool, 4> castlingRights;
-    bool wasEnPassantCapture;
-    Position enPassantCapturePos;
-};
-
 class ChessLogic {
 public:
     ChessLogic(Board& board);
     
-    // Get all legal moves for a piece at position
+    // Start over from the board's current position after it was set up again
+    // (history dropped; the move counters come from the FEN when there is one)
+    void reset(int halfmoveClock = 0, int fullmoveNumber = 1);
+    
+    // Set up the board from a FEN string and start over, halfmove clock included
+    // (returns false on malformed input; the board is then unspecified)
+    bool loadFEN(const std::string& fen);
+    
+    // FEN of the current position, with both move counters
+    std::string toFEN() const { return m_board.toFEN(m_halfmoveClock, m_fullmoveNumber); }
+    
+    // Get all legal moves for a piece at position (empty unless it is that piece's turn)
     std::vector<Move> getLegalMoves(const Position& pos) const;
     
     // Check if a move is legal
@@ -40,37 +43,84 @@ public:
     bool isStalemate(Color color) const;
     GameState getGameState() const;
     
+    // Board the rules are applied to
+    const Board& getBoard() const { return m_board; }
+    
+    // Half-moves since the last capture or pawn move (draw by the 50-move rule at 100)
+    int getHalfmoveClock() const { return m_halfmoveClock; }
+    
+    // Number of the current move, starting at 1 and incremented after Black's move
+    int getFullmoveNumber() const { return m_fullmoveNumber; }
+    
+    // Moves played since the last reset, oldest first
+    std::vector<Move> getMoveHistory() const;
+    
+    // Earlier occurrences of the current position (draw by threefold repetition at 2)
+    int countRepetitions() const;
+    
+    // Keys of the positions played since the last capture or pawn move, oldest first
+    // and the current one excluded: the only ones a later position can repeat
+    std::vector<std::uint64_t> getRepetitionWindow() const;
+    
     // Get current turn
     Color getCurrentTurn() const { return m_currentTurn; }
     
     // Get all legal moves for a specific color (for AI)
     std::vector<Move> getAllLegalMoves(Color color) const;
+    // Same, appended to a caller-owned list without any allocation
+    void getAllLegalMoves(Color color, MoveList& moves) const;
     
     // Check if position is attacked by a color
     bool isAttacked(const Position& pos, Color byColor) const;
+    
+    // Count leaf positions at the given depth from the current position (perft)
+    std::uint64_t perft(int depth);
 
 private:
     Board& m_board;
     Color m_currentTurn;
-    std::vector<MoveRecord> m_moveHistory;
+    
+    // Each move played with the key and halfmove clock of the position before it
+    struct HistoryEntry {
+        MoveRecord record;
+        std::uint64_t hash;
+        int halfmoveClock;
+    };
+    std::vector<HistoryEntry> m_moveHistory;
+    int m_halfmoveClock;
+    int m_fullmoveNumber;
+    
+    // Legal moves and state of the current position, computed on first use
+    // and invalidated by makeMove/undoMove
+    struct PositionCache {
+        MoveList moves;
+        GameState state = GameState::Playing;
+        bool valid = false;
+    };
+    mutable PositionCache m_cache;
+    
+    const PositionCache& positionCache() const;
+    void generateAllLegalMoves(Color color, MoveList& moves) const;
+    
+    // Append the legal moves of the piece at pos, whatever the side to move
+    // (info holds the checks and pins against that piece's king)
+    void generateLegalMoves(const Position& pos, const LegalityInfo& info, MoveList& moves) const;
+    bool hasLegalMove(Color color) const;
     
     // Generate pseudo-legal moves (before checking if king is in check)
-    std::vector<Move> getPseudoLegalMoves(const Position& pos) const;
+    void getPseudoLegalMoves(const Position& pos, MoveList& moves) const;
     
-    // Move generators for each piece type
-    std::vector<Move> getPawnMoves(const Position& pos) const;
-    std::vector<Move> getKnightMoves(const Position& pos) const;
-    std::vector<Move> getBishopMoves(const Position& pos) const;
-    std::vector<Move> getRookMoves(const Position& pos) const;
-    std::vector<Move> getQueenMoves(const Position& pos) const;
-    std::vector<Move> getKingMoves(const Position& pos) const;
+    // Move generators for each piece type, appending to moves
+    void getPawnMoves(const Position& pos, MoveList& moves) const;
+    void getKnightMoves(const Position& pos, MoveList& moves) const;
+    void getBishopMoves(const Position& pos, MoveList& moves) const;
+    void getRookMoves(const Position& pos, MoveList& moves) const;
+    void getQueenMoves(const Position& pos, MoveList& moves) const;
+    void getKingMoves(const Position& pos, MoveList& moves) const;
     
     // Sliding piece move generation helper
-    std::vector<Move> getSlidingMoves(const Position& pos, 
-                                       const std::vector<std::pair<int, int>>& directions) const;
-    
-    // Check if a move would leave own king in check
-    bool wouldBeInCheck(const Move& move) const;
+    void getSlidingMoves(const Position& pos, const int (*directions)[2], int count,
+                         MoveList& moves) const;
 };
 
 } // namespace Chess
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Types.hpp"
+#include "Board.hpp"
+#include "ChessLogic.hpp"
+#include "AIPlayer.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Chess {
+
+// Limites d'une analyse : temps par position et/ou profondeur (0 = non borné ;
+// sans aucune limite, la profondeur du niveau Master)
+struct AnalysisLimits {
+    int moveTimeMs = 0;
+    int depth = 0;
+};
+
+// Résultat d'une position : meilleur coup et évaluation de la même recherche
+struct AnalysisResult {
+    std::string fen;
+    bool valid = false;         // FEN lisible et au moins un coup légal
+    Move bestMove;
+    int score = 0;              // du point de vue du joueur au trait
+    int depth = 0;
+    std::uint64_t nodes = 0;
+    int elapsedMs = 0;
+    std::vector<Move> pv;
+};
+
+// Ensemble de moteurs indépendants (board, règles et AIPlayer mono-thread avec sa
+// propre table de transposition), un thread de travail par moteur. Les positions
+// soumises sont réparties sur les moteurs libres : le débit croît avec le nombre de
+// cœurs au lieu d'une seule recherche à la fois. Utilisable depuis plusieurs threads.
+class EnginePool {
+public:
+    // instances = 0 : un moteur par cœur
+    explicit EnginePool(int instances = 0, std::size_t hashMegabytes = TranspositionTable::DEFAULT_SIZE_MB);
+    ~EnginePool();
+    EnginePool(const EnginePool&) = delete;
+    EnginePool& operator=(const EnginePool&) = delete;
+
+    int size() const { return static_cast<int>(m_instances.size()); }
+
+    // Une position, résultat asynchrone
+    std::future<AnalysisResult> submit(const std::string& fen, const AnalysisLimits& limits);
+
+    // Un lot de positions cherchées en parallèle, résultats dans l'ordre des FEN
+    std::vector<AnalysisResult> analyse(const std::vector<std::string>& fens, const AnalysisLimits& limits);
+
+private:
+    struct Instance {
+        Board board;
+        ChessLogic logic;
+        AIPlayer ai;
+
+        Instance() : logic(board), ai(board, logic) {}
+    };
+
+    struct Job {
+        std::string fen;
+        AnalysisLimits limits;
+        std::promise<AnalysisResult> result;
+    };
+
+    void workerLoop(Instance& instance);
+    static AnalysisResult run(Instance& instance, const std::string& fen, const AnalysisLimits& limits);
+
+    std::vector<std::unique_ptr<Instance>> m_instances;
+    std::vector<std::thread> m_workers;
+
+    // File des positions en attente, partagée par les threads de travail
+    std::deque<Job> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    bool m_stopping;
+};
+
+} // namespace Chess
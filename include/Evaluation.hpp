@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+
+namespace Chess {
+
+namespace Eval {
+
+// Piece values indexed by PieceType
+inline constexpr std::array<int, 7> PIECE_VALUE = {0, 100, 320, 330, 500, 900, 20000};
+
+namespace detail {
+
+using Table = std::array<std::array<int, 8>, 8>;
+
+// Piece-square bonuses from White's point of view (row 0 = rank 8)
+inline constexpr Table PAWN = {{
+    {  0,  0,  0,  0,  0,  0,  0,  0 },
+    { 50, 50, 50, 50, 50, 50, 50, 50 },
+    { 10, 10, 20, 30, 30, 20, 10, 10 },
+    {  5,  5, 10, 25, 25, 10,  5,  5 },
+    {  0,  0,  0, 20, 20,  0,  0,  0 },
+    {  5, -5,-10,  0,  0,-10, -5,  5 },
+    {  5, 10, 10,-20,-20, 10, 10,  5 },
+    {  0,  0,  0,  0,  0,  0,  0,  0 }
+}};
+
+inline constexpr Table KNIGHT = {{
+    {-50,-40,-30,-30,-30,-30,-40,-50 },
+    {-40,-20,  0,  0,  0,  0,-20,-40 },
+    {-30,  0, 10, 15, 15, 10,  0,-30 },
+    {-30,  5, 15, 20, 20, 15,  5,-30 },
+    {-30,  0, 15, 20, 20, 15,  0,-30 },
+    {-30,  5, 10, 15, 15, 10,  5,-30 },
+    {-40,-20,  0,  5,  5,  0,-20,-40 },
+    {-50,-40,-30,-30,-30,-30,-40,-50 }
+}};
+
+inline constexpr Table BISHOP = {{
+    {-20,-10,-10,-10,-10,-10,-10,-20 },
+    {-10,  0,  0,  0,  0,  0,  0,-10 },
+    {-10,  0,  5, 10, 10,  5,  0,-10 },
+    {-10,  5,  5, 10, 10,  5,  5,-10 },
+    {-10,  0, 10, 10, 10, 10,  0,-10 },
+    {-10, 10, 10, 10, 10, 10, 10,-10 },
+    {-10,  5,  0,  0,  0,  0,  5,-10 },
+    {-20,-10,-10,-10,-10,-10,-10,-20 }
+}};
+
+inline constexpr Table ROOK = {{
+    {  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  5, 10, 10, 10, 10, 10, 10,  5 },
+    { -5,  0,  0,  0,  0,  0,  0, -5 },
+    { -5,  0,  0,  0,  0,  0,  0, -5 },
+    { -5,  0,  0,  0,  0,  0,  0, -5 },
+    { -5,  0,  0,  0,  0,  0,  0, -5 },
+    { -5,  0,  0,  0,  0,  0,  0, -5 },
+    {  0,  0,  0,  5,  5,  0,  0,  0 }
+}};
+
+inline constexpr Table QUEEN = {{
+    {-20,-10,-10, -5, -5,-10,-10,-20 },
+    {-10,  0,  0,  0,  0,  0,  0,-10 },
+    {-10,  0,  5,  5,  5,  5,  0,-10 },
+    { -5,  0,  5,  5,  5,  5,  0, -5 },
+    {  0,  0,  5,  5,  5,  5,  0, -5 },
+    {-10,  5,  5,  5,  5,  5,  0,-10 },
+    {-10,  0,  5,  0,  0,  0,  0,-10 },
+    {-20,-10,-10, -5, -5,-10,-10,-20 }
+}};
+
+inline constexpr Table KING = {{
+    {-30,-40,-40,-50,-50,-40,-40,-30 },
+    {-30,-40,-40,-50,-50,-40,-40,-30 },
+    {-30,-40,-40,-50,-50,-40,-40,-30 },
+    {-30,-40,-40,-50,-50,-40,-40,-30 },
+    {-20,-30,-30,-40,-40,-30,-30,-20 },
+    {-10,-20,-20,-20,-20,-20,-20,-10 },
+    { 20, 20,  0,  0,  0,  0, 20, 20 },
+    { 20, 30, 10,  0,  0, 10, 30, 20 }
+}};
+
+// Value plus bonus per [colour][type][square]; Black reads the tables mirrored vertically
+constexpr std::array<std::array<std::array<int, 64>, 7>, 2> makePieceSquareTable() {
+    const Table* tables[7] = {nullptr, &PAWN, &KNIGHT, &BISHOP, &ROOK, &QUEEN, &KING};
+    std::array<std::array<std::array<int, 64>, 7>, 2> result{};
+    for (int side = 0; side < 2; ++side) {
+        for (int type = 1; type < 7; ++type) {
+            for (int sq = 0; sq < 64; ++sq) {
+                int row = sq >> 3;
+                int col = sq & 7;
+                int tableRow = side == 0 ? row : 7 - row;
+                result[side][type][sq] = PIECE_VALUE[type] + (*tables[type])[tableRow][col];
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace detail
+
+inline constexpr std::array<std::array<std::array<int, 64>, 7>, 2> PIECE_SQUARE = detail::makePieceSquareTable();
+
+} // namespace Eval
+
+} // namespace Chess
@@ -9,6 +9,7 @@
 #include <SFML/Graphics.hpp>
 #include <memory>
 #include <optional>
+#include <future>
 
 namespace Chess {
 
@@ -47,9 +48,14 @@ public:
 
 private:
     void processEvents();
+    void handleEvent(const sf::Event& event);
     void update(float dt);
     void render();
     
+    // Nothing to redraw: sleep in waitEvent until input or the next scheduled change
+    void waitForEvent();
+    int nextWakeupMs() const;
+    
     void handleClick(int x, int y);
     void handlePromotion(PieceType type);
     void selectPiece(const Position& pos);
@@ -58,6 +64,8 @@ private:
     void drawPromotionDialog();
     
     void resetGame();
+    // AIPlayer neuf sur m_board et m_logic, avec ses threads et le livre d'ouvertures
+    void createAIPlayer();
     
     // Menu functions
     void handleMenuClick(int x, int y);
@@ -70,8 +78,11 @@ private:
     std::string formatTime(float seconds);
     
     // AI functions
-    void makeAIMove();
+    void startAIMove();
+    void makeAIMove(const Move& bestMove);
     void updateAI();
+    void updateAIClock();
+    void onPlayerMove(const Move& move);
 
 private:
     std::unique_ptr<sf::RenderWindow> m_window;
@@ -80,6 +91,8 @@ private:
     std::unique_ptr<Renderer> m_renderer;
     std::unique_ptr<SoundManager> m_soundManager;
     std::unique_ptr<AIPlayer> m_aiPlayer;
+    // Ouverture des tables de finales lancée par initialize, terminée avant la première partie
+    std::future<bool> m_tablebaseLoading;
     
     std::optional<Position> m_selectedPosition;
     std::vector<Move> m_currentLegalMoves;
@@ -90,6 +103,8 @@ private:
     GameState m_gameState;
     
     sf::Clock m_clock;
+    // Set by input, animation, clock ticks and moves; the frame is drawn only then
+    bool m_needsRedraw;
     sf::Font m_menuFont;
     
     // Menu buttons
@@ -120,9 +135,14 @@ private:
     // AI state
     bool m_aiThinking;
     Color m_aiColor;
+    bool m_ponderEnabled;
     
     static constexpr int WINDOW_WIDTH = 1000;
     static constexpr int WINDOW_HEIGHT = 850;
+    static constexpr const char* BOOK_PATH = "book.bin";
+    static constexpr const char* SYZYGY_PATH = "syzygy";
+    static constexpr int IDLE_WAIT_MS = 500;
+    static constexpr int AI_POLL_MS = 10;
 };
 
 } // namespace Chess
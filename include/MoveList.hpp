@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Types.hpp"
+#include "PackedMove.hpp"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace Chess {
+
+// Fixed-capacity list living on the stack: move generators append into it so
+// the search never touches the heap. 256 is well above the maximum number of
+// legal moves in any reachable chess position (218).
+template <typename T, std::size_t Capacity = 256>
+class BasicMoveList {
+    static_assert(std::is_trivially_destructible<T>::value, "moves are dropped without destruction");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    void push_back(const T& move) { new (data() + m_size++) T(move); }
+    void pop_back() { --m_size; }
+    void clear() { m_size = 0; }
+    // Shrinks the list, used by in-place filters
+    void resize(std::size_t size) { m_size = size; }
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    T* data() { return std::launder(reinterpret_cast<T*>(m_storage)); }
+    const T* data() const { return std::launder(reinterpret_cast<const T*>(m_storage)); }
+
+    T& operator[](std::size_t i) { return data()[i]; }
+    const T& operator[](std::size_t i) const { return data()[i]; }
+    T& front() { return data()[0]; }
+    const T& front() const { return data()[0]; }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + m_size; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + m_size; }
+
+private:
+    // Raw storage: unlike std::array<Move, N>, nothing is constructed up front
+    alignas(T) unsigned char m_storage[Capacity * sizeof(T)];
+    std::size_t m_size = 0;
+};
+
+using MoveList = BasicMoveList<Move>;
+// Engine lists: 2 bytes per move instead of sizeof(Move)
+using PackedMoveList = BasicMoveList<PackedMove>;
+
+} // namespace Chess
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Board.hpp"
+#include "PackedMove.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Chess {
+
+// Coup du livre pour une position. À la lecture le coup ne porte que départ, arrivée,
+// promotion et roque : il est comparé aux coups générés avant d'être joué
+struct BookEntry {
+    std::uint64_t key = 0;
+    PackedMove move;
+    std::uint16_t weight = 0;
+};
+
+// Livre d'ouvertures au format propre au moteur, écrit par l'outil makebook. Les entrées
+// reprennent la disposition des .bin de Polyglot (16 octets big-endian : clé 8, coup 2,
+// poids 2, apprentissage 4, triées par clé), mais les clés sont les clés Zobrist de
+// Board et non les Random64 de Polyglot : un livre Polyglot n'est pas lisible ici, et
+// un livre makebook ne l'est pas par les outils Polyglot.
+// Le fichier est projeté en mémoire (mmap) et parcouru par dichotomie, sans copie.
+class OpeningBook {
+public:
+    OpeningBook() = default;
+    ~OpeningBook();
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    // Projette le fichier en mémoire (ferme le livre précédent)
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+    std::size_t size() const { return m_count; }
+
+    // Coups du livre pour la position, par poids décroissant (vide si absente)
+    std::vector<BookEntry> probe(const Board& board) const;
+
+    // Trie les entrées et écrit le livre (coups complets, roques marqués comme tels)
+    static bool write(const std::string& path, std::vector<BookEntry> entries);
+
+    static constexpr std::size_t ENTRY_SIZE = 16;
+
+private:
+    std::uint64_t keyAt(std::size_t index) const;
+
+    // Codage des coups repris de Polyglot (le roque y est noté roi prend tour)
+    static std::uint16_t encodeMove(PackedMove move);
+    static PackedMove decodeMove(const Board& board, std::uint16_t raw);
+
+    // Projection du fichier entier : une fin incomplète n'est pas lue mais reste projetée
+    const unsigned char* m_data = nullptr;
+    std::size_t m_mappedLength = 0;
+    std::size_t m_count = 0;
+};
+
+} // namespace Chess
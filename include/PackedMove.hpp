@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Types.hpp"
+#include "Bitboard.hpp"
+#include <cstdint>
+
+namespace Chess {
+
+// Engine move on 16 bits: from (6) | to (6) << 6 | flags (4) << 12.
+// Flags follow the usual layout: bit 2 = capture, bit 3 = promotion (the low two
+// bits then give the piece), 2/3 = castling, 5 = en passant. The value 0 is
+// never a real move (a8 to a8) and stands for "no move".
+class PackedMove {
+public:
+    enum Flags : std::uint16_t {
+        Quiet = 0,
+        DoublePush = 1,     // reserved: Move does not tell it apart from a quiet move
+        KingCastle = 2,
+        QueenCastle = 3,
+        Capture = 4,
+        EnPassant = 5,
+        Promotion = 8,
+        PromotionCapture = 12
+    };
+
+    constexpr PackedMove() = default;
+    constexpr PackedMove(int from, int to, int flags)
+        : m_data(static_cast<std::uint16_t>(from | (to << 6) | (flags << 12))) {}
+
+    static constexpr PackedMove fromRaw(std::uint16_t raw) {
+        PackedMove move;
+        move.m_data = raw;
+        return move;
+    }
+
+    static PackedMove fromMove(const Move& move) {
+        int flags = Quiet;
+        if (move.isCastling) {
+            flags = move.to.col > move.from.col ? KingCastle : QueenCastle;
+        } else if (move.isEnPassant) {
+            flags = EnPassant;
+        } else {
+            if (move.isCapture) flags |= Capture;
+            if (move.promotion != PieceType::None) {
+                flags |= Promotion | (typeIndex(move.promotion) - typeIndex(PieceType::Knight));
+            }
+        }
+        return PackedMove(squareIndex(move.from), squareIndex(move.to), flags);
+    }
+
+    // Same convention as the generators: en passant is flagged apart, not as a capture
+    Move toMove() const {
+        Move move = {squarePosition(from()), squarePosition(to())};
+        move.promotion = promotion();
+        move.isCapture = isCapture() && !isEnPassant();
+        move.isCastling = isCastling();
+        move.isEnPassant = isEnPassant();
+        return move;
+    }
+
+    constexpr int from() const { return m_data & 63; }
+    constexpr int to() const { return (m_data >> 6) & 63; }
+    constexpr int flags() const { return m_data >> 12; }
+    constexpr std::uint16_t raw() const { return m_data; }
+
+    constexpr bool isNull() const { return m_data == 0; }
+    constexpr bool isCapture() const { return (flags() & Capture) != 0; }
+    constexpr bool isPromotion() const { return (flags() & Promotion) != 0; }
+    constexpr bool isCastling() const { return flags() == KingCastle || flags() == QueenCastle; }
+    constexpr bool isEnPassant() const { return flags() == EnPassant; }
+
+    constexpr PieceType promotion() const {
+        return isPromotion() ? static_cast<PieceType>(typeIndex(PieceType::Knight) + (flags() & 3))
+                             : PieceType::None;
+    }
+
+    constexpr bool operator==(const PackedMove& other) const { return m_data == other.m_data; }
+    constexpr bool operator!=(const PackedMove& other) const { return m_data != other.m_data; }
+
+private:
+    std::uint16_t m_data = 0;
+};
+
+} // namespace Chess
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Types.hpp"
+#include "Board.hpp"
+#include "ChessLogic.hpp"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Chess {
+
+// One game of a PGN file: its tag pairs, the moves from the starting
+// position (the FEN tag when present) and the result
+struct PgnGame {
+    std::vector<std::pair<std::string, std::string>> tags;
+    std::vector<Move> moves;
+    std::string result = "*";
+
+    // False when a move could not be read or is illegal: moves then stops
+    // before it and error tells what went wrong
+    bool valid = true;
+    std::string error;
+
+    // Value of a tag, empty when absent
+    std::string tag(std::string_view name) const;
+    void setTag(const std::string& name, const std::string& value);
+
+    // Starting position: the FEN tag, or the standard start position
+    std::string startFEN() const;
+};
+
+namespace Pgn {
+
+extern const char* const START_FEN;
+
+// Standard Algebraic Notation of a legal move in the current position,
+// check and mate suffixes included ("Nbd7", "exd6", "O-O", "e8=Q+")
+std::string toSan(ChessLogic& logic, const Move& move);
+
+// Finds the legal move written in SAN (suffixes, annotations and "0-0"
+// tolerated); false when the text matches no legal move or several
+bool parseSan(const ChessLogic& logic, std::string_view san, Move& move);
+
+// Writes a game in export format: the seven-tag roster first, then the
+// remaining tags and the movetext wrapped at 80 columns
+void write(std::ostream& out, const PgnGame& game);
+
+// A game played on a ChessLogic since its last reset (startFEN is the position
+// it was reset from), with the given tags
+PgnGame fromLogic(const ChessLogic& logic, const std::string& startFEN,
+                  const std::vector<std::pair<std::string, std::string>>& tags = {});
+
+} // namespace Pgn
+
+// Streaming reader of PGN files. The file is memory-mapped and tokenized in
+// place with string_views: only the current game is ever decoded, so files
+// far larger than memory can be replayed one game at a time. Every move is
+// checked against the rules on the reader's own board, comments, variations
+// and NAGs are skipped.
+class PgnReader {
+public:
+    PgnReader();
+    ~PgnReader();
+    PgnReader(const PgnReader&) = delete;
+    PgnReader& operator=(const PgnReader&) = delete;
+
+    // Maps a file (false if it cannot be opened), or reads from a caller-owned buffer
+    bool open(const std::string& path);
+    void openBuffer(std::string_view text);
+    void close();
+
+    // Next game of the file, false at the end. An unreadable game still comes
+    // back with valid = false, so a broken game never stops the file.
+    bool next(PgnGame& game);
+
+    // Byte position in the input, for progress reports
+    std::size_t offset() const { return m_pos; }
+    std::size_t size() const { return m_text.size(); }
+
+private:
+    void skipSpaceAndComments();
+    bool readTag(PgnGame& game);
+    std::string_view readToken();
+    void skipVariation();
+
+    std::string_view m_text;
+    std::size_t m_pos;
+
+    // Mapping owned by the reader (null when reading a caller's buffer)
+    void* m_mapping;
+    std::size_t m_mappingSize;
+
+    Board m_board;
+    ChessLogic m_logic;
+};
+
+} // namespace Chess
@@ -1,19 +1,24 @@
 #pragma once
 
 #include "Types.hpp"
+#include <cstdint>
 
 namespace Chess {
 
+// One byte per piece: type in bits 0-2, color in bits 3-4, moved flag in bit 5
 class Piece {
 public:
-    Piece();
-    Piece(PieceType type, Color color);
+    constexpr Piece() : m_data(0) {}
+    constexpr Piece(PieceType type, Color color)
+        : m_data(static_cast<std::uint8_t>(static_cast<int>(type) | (static_cast<int>(color) << COLOR_SHIFT))) {}
     
-    PieceType getType() const { return m_type; }
-    Color getColor() const { return m_color; }
-    bool isEmpty() const { return m_type == PieceType::None; }
-    bool hasMoved() const { return m_hasMoved; }
-    void setMoved(bool moved) { m_hasMoved = moved; }
+    PieceType getType() const { return static_cast<PieceType>(m_data & TYPE_MASK); }
+    Color getColor() const { return static_cast<Color>((m_data >> COLOR_SHIFT) & COLOR_MASK); }
+    bool isEmpty() const { return (m_data & TYPE_MASK) == 0; }
+    bool hasMoved() const { return (m_data & MOVED_BIT) != 0; }
+    void setMoved(bool moved) {
+        m_data = static_cast<std::uint8_t>(moved ? (m_data | MOVED_BIT) : (m_data & ~MOVED_BIT));
+    }
     
     // Get Unicode character for the piece
     char32_t getUnicodeChar() const;
@@ -22,9 +27,14 @@ public:
     int getValue() const;
 
 private:
-    PieceType m_type;
-    Color m_color;
-    bool m_hasMoved;
+    static constexpr std::uint8_t TYPE_MASK = 0x07;
+    static constexpr int COLOR_SHIFT = 3;
+    static constexpr std::uint8_t COLOR_MASK = 0x03;
+    static constexpr std::uint8_t MOVED_BIT = 0x20;
+    
+    std::uint8_t m_data;
 };
 
+static_assert(sizeof(Piece) == 1, "Piece must stay packed in a single byte");
+
 } // namespace Chess
@@ -6,6 +6,7 @@
 #include <vector>
 #include <string>
 #include <optional>
+#include <future>
 
 namespace Chess {
 
@@ -13,7 +14,12 @@ class Renderer {
 public:
     Renderer(sf::RenderWindow& window, const Board& board);
     
-    bool loadResources();
+    // Font probing runs on background tasks, one per candidate path: startLoading
+    // returns at once, finishLoading waits for the first font that opens and builds
+    // the cached layers (it must run on the thread owning the window's GL context)
+    void startLoading();
+    bool finishLoading();
+    bool loadResources() { startLoading(); return finishLoading(); }
     void render(const Position* selectedPos = nullptr, 
                 const std::vector<Move>* legalMoves = nullptr,
                 GameState gameState = GameState::Playing,
@@ -39,6 +45,13 @@ private:
     const Board& m_board;
     
     std::optional<sf::Font> m_font;
+    std::vector<std::future<std::optional<sf::Font>>> m_fontLoading;
+    
+    // Built once by finishLoading: the static board (frame, tiles, coordinates) and
+    // an atlas holding the twelve piece glyphs with their shadow and outline
+    std::optional<sf::RenderTexture> m_boardLayer;
+    std::optional<sf::RenderTexture> m_pieceAtlas;
+    sf::VertexArray m_pieceVertices;
     
     float m_tileSize;
     sf::Vector2f m_boardOffset;
@@ -60,14 +73,18 @@ private:
     static constexpr float ANIM_DURATION = 0.2f;
     
     // Rendering methods
-    void drawBoard();
-    void drawCoordinates();
+    void buildStaticLayers();
+    void drawBoardFrame(sf::RenderTarget& target);
+    void drawBoard(sf::RenderTarget& target);
+    void drawCoordinates(sf::RenderTarget& target);
     void drawPieces(const Position* selectedPos);
     void drawHighlights(const Position* selectedPos, 
                         const std::vector<Move>* legalMoves);
     void drawGameState(GameState state, Color currentTurn);
     void drawGameOverOverlay(GameState state, Color currentTurn);
-    void drawPiece(const Piece& piece, float x, float y, float alpha = 1.0f);
+    void drawPiece(sf::RenderTarget& target, const Piece& piece, float x, float y, float alpha = 1.0f);
+    // Queue one piece quad from the atlas into m_pieceVertices
+    void appendPiece(const Piece& piece, float x, float y, float alpha);
     
     // Get piece character from Unicode font
     sf::String getPieceString(const Piece& piece) const;
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Types.hpp"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace Chess {
+
+// Résultat d'une itération complète de l'approfondissement itératif
+struct IterationStats {
+    int depth = 0;
+    int score = 0;
+    std::uint64_t nodes = 0;  // nœuds de tous les threads depuis le début de la recherche
+    int elapsedMs = 0;
+};
+
+// Statistiques remplies par chaque recherche de AIPlayer
+struct SearchStats {
+    std::uint64_t nodes = 0;             // tous threads confondus, quiescence comprise
+    std::uint64_t qnodes = 0;            // nœuds de quiescence
+    std::uint64_t cutoffs = 0;           // coupures beta
+    std::uint64_t firstMoveCutoffs = 0;  // coupures obtenues dès le premier coup essayé
+    std::uint64_t ttProbes = 0;
+    std::uint64_t ttHits = 0;
+    std::uint64_t tbHits = 0;            // positions résolues par les tables de finales
+    int depth = 0;                       // dernière itération terminée
+    int score = 0;                       // du point de vue du joueur au trait
+    int elapsedMs = 0;
+    int threads = 1;
+    bool bookMove = false;               // coup joué depuis le livre d'ouvertures, sans recherche
+    bool tablebaseMove = false;          // coup joué depuis les tables de finales, sans recherche
+    std::vector<Move> pv;
+    std::vector<IterationStats> iterations;
+
+    void reset() { *this = SearchStats(); }
+
+    std::uint64_t nps() const {
+        return elapsedMs > 0 ? nodes * 1000 / static_cast<std::uint64_t>(elapsedMs) : nodes * 1000;
+    }
+    // Proportion des coupures faites par le premier coup : mesure la qualité de l'ordre des coups
+    double firstMoveCutoffRate() const {
+        return cutoffs ? static_cast<double>(firstMoveCutoffs) / cutoffs : 0.0;
+    }
+    double ttHitRate() const {
+        return ttProbes ? static_cast<double>(ttHits) / ttProbes : 0.0;
+    }
+    // Facteur de branchement effectif entre les deux dernières itérations
+    double branchingFactor() const;
+};
+
+// Une ligne lisible pour les journaux : profondeur, score, nœuds, nps, taux, variation principale
+std::ostream& operator<<(std::ostream& out, const SearchStats& stats);
+
+} // namespace Chess
@@ -5,13 +5,21 @@
 #include <cmath>
 #include <memory>
 #include <cstdint>
+#include <future>
+#include <random>
 
 namespace Chess {
 
+// The samples are synthesized on a background task started by the constructor;
+// each buffer is attached on the main thread once they are ready, and a sound
+// asked for before that is simply skipped
 class SoundManager {
 public:
     SoundManager();
     
+    // True once the buffers are attached (polls the background task, never blocks)
+    bool isReady();
+    
     void playMove();
     void playCapture();
     void playCheck();
@@ -22,8 +30,24 @@ public:
     void setVolume(float volume);
     
 private:
-    void generateTone(std::vector<std::int16_t>& samples, float frequency, float duration, float volume = 0.5f);
-    void generateClick(std::vector<std::int16_t>& samples);
+    struct Samples {
+        std::vector<std::int16_t> move;
+        std::vector<std::int16_t> capture;
+        std::vector<std::int16_t> check;
+        std::vector<std::int16_t> gameOver;
+        std::vector<std::int16_t> menuClick;
+        std::vector<std::int16_t> menuHover;
+    };
+    
+    // Pure computation, safe to run off the main thread
+    static Samples synthesize();
+    static void generateTone(std::vector<std::int16_t>& samples, float frequency, float duration, float volume = 0.5f);
+    static void generateClick(std::vector<std::int16_t>& samples, std::minstd_rand& noise);
+    
+    void play(const sf::SoundBuffer& buffer, float volume);
+    
+    std::future<Samples> m_pending;
+    bool m_ready;
     
     sf::SoundBuffer m_moveBuffer;
     sf::SoundBuffer m_captureBuffer;
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Board.hpp"
+#include "PackedMove.hpp"
+#include <string>
+
+namespace Chess {
+
+// Tables de finales Syzygy (WDL/DTZ) lues par la bibliothèque Fathom.
+// Compilé avec -DCHESS_USE_FATHOM (make FATHOM=<dossier src de Fathom>) ; sinon
+// toutes les fonctions répondent « indisponible » et la recherche n'en tient pas compte.
+// Fathom projette les fichiers en mémoire et ne charge une table qu'au premier accès.
+namespace Tablebase {
+
+// Résultat du point de vue du joueur au trait (victoire/défaite « maudites » :
+// annulées par la règle des 50 coups)
+enum class Wdl {
+    Loss,
+    BlessedLoss,
+    Draw,
+    CursedWin,
+    Win
+};
+
+// Charge les tables du dossier (plusieurs dossiers séparés par ':'), état global partagé
+bool init(const std::string& path);
+void release();
+
+// Nombre de pièces des plus grandes tables trouvées (0 si aucune)
+int maxPieces();
+
+// Sondage possible : assez peu de pièces et plus aucun droit de roque
+bool canProbe(const Board& board, int pieceLimit);
+
+// Sondage WDL, utilisable depuis n'importe quel thread de recherche ; valable seulement
+// quand le compteur des 50 coups vient d'être remis à zéro (prise ou coup de pion)
+bool probeWdl(const Board& board, Wdl& result);
+
+// Meilleur coup à la racine d'après les tables DTZ (départ, arrivée et promotion
+// seulement), compte tenu des demi-coups déjà joués vers la règle des 50 coups ;
+// les appels concurrents sont sérialisés
+bool probeRoot(const Board& board, int halfmoveClock, PackedMove& move, Wdl& result);
+
+} // namespace Tablebase
+
+} // namespace Chess
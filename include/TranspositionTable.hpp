@@ -0,0 +1,63 @@
+#pragma once
+
+#include "PackedMove.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Chess {
+
+// Type de borne stockée avec un score
+enum class Bound : std::uint8_t {
+    None = 0,
+    Exact,
+    Lower,  // score >= valeur stockée (coupure beta)
+    Upper   // score <= valeur stockée (aucun coup n'a dépassé alpha)
+};
+
+// Contenu d'une entrée : clé, score, profondeur, borne et meilleur coup compacté
+struct TTEntry {
+    std::uint64_t key = 0;
+    std::int32_t score = 0;
+    std::int8_t depth = 0;
+    Bound bound = Bound::None;
+    PackedMove move;
+
+    // Le meilleur coup n'est qu'une indication d'ordre : on le compare aux coups générés
+    bool hasMove() const { return !move.isNull(); }
+};
+
+// Table partagée entre les threads de recherche sans verrou : chaque case stocke
+// les données compactées sur 64 bits et la clé XOR ces données, une case à moitié
+// écrite par un autre thread ne correspond alors plus à aucune clé
+class TranspositionTable {
+public:
+    explicit TranspositionTable(std::size_t megabytes = DEFAULT_SIZE_MB);
+
+    // Redimensionne la table (la vide au passage)
+    void resize(std::size_t megabytes);
+    void clear();
+    std::size_t getSizeMB() const { return m_sizeMB; }
+
+    bool probe(std::uint64_t key, TTEntry& entry) const;
+    void store(std::uint64_t key, int depth, Bound bound, int score, PackedMove bestMove);
+
+    static constexpr std::size_t DEFAULT_SIZE_MB = 16;
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> keyXorData{0};
+        std::atomic<std::uint64_t> data{0};
+    };
+
+    static std::uint64_t pack(const TTEntry& entry);
+    static TTEntry unpack(std::uint64_t key, std::uint64_t data);
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_count;
+    std::size_t m_mask;
+    std::size_t m_sizeMB;
+};
+
+} // namespace Chess
@@ -6,6 +6,7 @@
 */
 #pragma once
 #include <cstdint>
+#include <string>
 
 namespace Chess {
 
@@ -49,6 +50,29 @@ struct Move {
     bool isCapture = false;
     bool isCastling = false;
     bool isEnPassant = false;
+    
+    // Same squares and promotion (the flags follow from the position)
+    bool operator==(const Move& other) const {
+        return from == other.from && to == other.to && promotion == other.promotion;
+    }
+    
+    bool operator!=(const Move& other) const {
+        return !(*this == other);
+    }
+    
+    // Long algebraic notation as used by UCI, e.g. "e2e4" or "e7e8q"
+    std::string toUci() const {
+        std::string uci = {char('a' + from.col), char('8' - from.row),
+                           char('a' + to.col), char('8' - to.row)};
+        switch (promotion) {
+            case PieceType::Queen:  uci += 'q'; break;
+            case PieceType::Rook:   uci += 'r'; break;
+            case PieceType::Bishop: uci += 'b'; break;
+            case PieceType::Knight: uci += 'n'; break;
+            default: break;
+        }
+        return uci;
+    }
 };
 
 enum class GameState {
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace Chess {
+
+namespace Zobrist {
+
+// Random keys generated at compile time with splitmix64
+struct Keys {
+    std::array<std::array<std::array<std::uint64_t, 64>, 7>, 2> pieces{}; // [colour][type][square]
+    std::array<std::uint64_t, 4> castling{};  // same order as Board castling rights
+    std::array<std::uint64_t, 8> enPassantFile{};
+    std::uint64_t blackToMove = 0;
+};
+
+namespace detail {
+
+constexpr std::uint64_t splitmix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+constexpr Keys makeKeys() {
+    Keys keys;
+    std::uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (auto& side : keys.pieces) {
+        for (auto& type : side) {
+            for (auto& key : type) {
+                key = splitmix64(state);
+            }
+        }
+    }
+    for (auto& key : keys.castling) key = splitmix64(state);
+    for (auto& key : keys.enPassantFile) key = splitmix64(state);
+    keys.blackToMove = splitmix64(state);
+    return keys;
+}
+
+} // namespace detail
+
+inline constexpr Keys KEYS = detail::makeKeys();
+
+} // namespace Zobrist
+
+} // namespace Chess
@@ -1,549 +1,735 @@
 #include "AIPlayer.hpp"
+#include "Evaluation.hpp"
 #include <algorithm>
-#include <limits>
 #include <cmath>
+#include <thread>
 
 namespace Chess {
 
-// Tables de bonus de position (du point de vue des blancs, row 0 = rang 8)
-const int AIPlayer::PAWN_TABLE[8][8] = {
-    {  0,  0,  0,  0,  0,  0,  0,  0 },
-    { 50, 50, 50, 50, 50, 50, 50, 50 },
-    { 10, 10, 20, 30, 30, 20, 10, 10 },
-    {  5,  5, 10, 25, 25, 10,  5,  5 },
-    {  0,  0,  0, 20, 20,  0,  0,  0 },
-    {  5, -5,-10,  0,  0,-10, -5,  5 },
-    {  5, 10, 10,-20,-20, 10, 10,  5 },
-    {  0,  0,  0,  0,  0,  0,  0,  0 }
-};
-
-const int AIPlayer::KNIGHT_TABLE[8][8] = {
-    {-50,-40,-30,-30,-30,-30,-40,-50 },
-    {-40,-20,  0,  0,  0,  0,-20,-40 },
-    {-30,  0, 10, 15, 15, 10,  0,-30 },
-    {-30,  5, 15, 20, 20, 15,  5,-30 },
-    {-30,  0, 15, 20, 20, 15,  0,-30 },
-    {-30,  5, 10, 15, 15, 10,  5,-30 },
-    {-40,-20,  0,  5,  5,  0,-20,-40 },
-    {-50,-40,-30,-30,-30,-30,-40,-50 }
-};
-
-const int AIPlayer::BISHOP_TABLE[8][8] = {
-    {-20,-10,-10,-10,-10,-10,-10,-20 },
-    {-10,  0,  0,  0,  0,  0,  0,-10 },
-    {-10,  0,  5, 10, 10,  5,  0,-10 },
-    {-10,  5,  5, 10, 10,  5,  5,-10 },
-    {-10,  0, 10, 10, 10, 10,  0,-10 },
-    {-10, 10, 10, 10, 10, 10, 10,-10 },
-    {-10,  5,  0,  0,  0,  0,  5,-10 },
-    {-20,-10,-10,-10,-10,-10,-10,-20 }
-};
-
-const int AIPlayer::ROOK_TABLE[8][8] = {
-    {  0,  0,  0,  0,  0,  0,  0,  0 },
-    {  5, 10, 10, 10, 10, 10, 10,  5 },
-    { -5,  0,  0,  0,  0,  0,  0, -5 },
-    { -5,  0,  0,  0,  0,  0,  0, -5 },
-    { -5,  0,  0,  0,  0,  0,  0, -5 },
-    { -5,  0,  0,  0,  0,  0,  0, -5 },
-    { -5,  0,  0,  0,  0,  0,  0, -5 },
-    {  0,  0,  0,  5,  5,  0,  0,  0 }
-};
-
-const int AIPlayer::QUEEN_TABLE[8][8] = {
-    {-20,-10,-10, -5, -5,-10,-10,-20 },
-    {-10,  0,  0,  0,  0,  0,  0,-10 },
-    {-10,  0,  5,  5,  5,  5,  0,-10 },
-    { -5,  0,  5,  5,  5,  5,  0, -5 },
-    {  0,  0,  5,  5,  5,  5,  0, -5 },
-    {-10,  5,  5,  5,  5,  5,  0,-10 },
-    {-10,  0,  5,  0,  0,  0,  0,-10 },
-    {-20,-10,-10, -5, -5,-10,-10,-20 }
-};
-
-const int AIPlayer::KING_TABLE[8][8] = {
-    {-30,-40,-40,-50,-50,-40,-40,-30 },
-    {-30,-40,-40,-50,-50,-40,-40,-30 },
-    {-30,-40,-40,-50,-50,-40,-40,-30 },
-    {-30,-40,-40,-50,-50,-40,-40,-30 },
-    {-20,-30,-30,-40,-40,-30,-30,-20 },
-    {-10,-20,-20,-20,-20,-20,-20,-10 },
-    { 20, 20,  0,  0,  0,  0, 20, 20 },
-    { 20, 30, 10,  0,  0, 10, 30, 20 }
-};
-
 AIPlayer::AIPlayer(Board& board, ChessLogic& logic)
     : m_board(board)
     , m_logic(logic)
     , m_difficulty(AIDifficulty::Medium)
-    , m_rng(std::random_device{}()) {
+    , m_depthLimit(0)
+    , m_rng(std::random_device{}())
+    , m_deterministic(false)
+    , m_tbPieceLimit(7)
+    , m_moveTimeMs(0)
+    , m_remainingTimeMs(0)
+    , m_timeBudgetMs(0)
+    , m_clockStartMs(0)
+    , m_stopSearch(false)
+    , m_pondering(false)
+    , m_rootColor(Color::White) {
+    setThreadCount(1);
+}
+
+AIPlayer::~AIPlayer() {
+    cancelSearch();
 }
 
 int AIPlayer::getPieceValue(PieceType type) const {
-    switch (type) {
-        case PieceType::Pawn:   return 100;
-        case PieceType::Knight: return 320;
-        case PieceType::Bishop: return 330;
-        case PieceType::Rook:   return 500;
-        case PieceType::Queen:  return 900;
-        case PieceType::King:   return 20000;
-        default: return 0;
+    return Eval::PIECE_VALUE[typeIndex(type)];
+}
+
+// Évaluation statique — du point de vue de l'IA
+// Matériel et bonus de position sont tenus à jour par le board à chaque coup : O(1)
+int AIPlayer::evaluateBoard(const Board& board, Color aiColor) const {
+    int score = board.getEvaluation();
+    return aiColor == Color::White ? score : -score;
+}
+
+// Roi absent = considéré en échec
+template <Color Us>
+bool AIPlayer::isInCheck(const Board& board) const {
+    Bitboard king = board.getPieces(Us, PieceType::King);
+    if (!king) return true;
+    return board.attackersTo<Side<Us>::THEM>(lsb(king), board.getOccupied()) != 0;
+}
+
+// Un coup par case atteinte, marqué prise si la case est occupée par l'adversaire
+static void addTargets(PackedMoveList& moves, int from, Bitboard targets, Bitboard enemies) {
+    while (targets) {
+        int to = popLsb(targets);
+        moves.push_back(PackedMove(from, to, (enemies & squareBit(to)) ? PackedMove::Capture : PackedMove::Quiet));
     }
 }
 
-int AIPlayer::getPositionBonus(const Position& pos, PieceType type, Color color) const {
-    int row = (color == Color::White) ? pos.row : (7 - pos.row);
-    int col = pos.col;
-    
-    switch (type) {
-        case PieceType::Pawn:   return PAWN_TABLE[row][col];
-        case PieceType::Knight: return KNIGHT_TABLE[row][col];
-        case PieceType::Bishop: return BISHOP_TABLE[row][col];
-        case PieceType::Rook:   return ROOK_TABLE[row][col];
-        case PieceType::Queen:  return QUEEN_TABLE[row][col];
-        case PieceType::King:   return KING_TABLE[row][col];
-        default: return 0;
+// Pions arrivés sur les cases données, partis de to - delta ; les quatre promotions
+// (dame d'abord) sur la dernière rangée
+template <Color Us, int Delta>
+static void addPawnMoves(PackedMoveList& moves, Bitboard targets, int flags) {
+    Bitboard promotions = targets & Side<Us>::PROMOTION_RANK;
+    targets &= ~Side<Us>::PROMOTION_RANK;
+    while (promotions) {
+        int to = popLsb(promotions);
+        for (int piece = 3; piece >= 0; --piece) {
+            moves.push_back(PackedMove(to - Delta, to, flags | PackedMove::Promotion | piece));
+        }
+    }
+    while (targets) {
+        int to = popLsb(targets);
+        moves.push_back(PackedMove(to - Delta, to, flags));
     }
 }
 
-// Évaluation statique — du point de vue de l'IA
-int AIPlayer::evaluateBoard(const Board& board, Color aiColor) const {
-    int score = 0;
+void AIPlayer::generateMoves(Board& board, Color color, PackedMoveList& moves, bool tacticalOnly) const {
+    if (color == Color::White) {
+        generateMoves<Color::White>(board, moves, tacticalOnly);
+    } else {
+        generateMoves<Color::Black>(board, moves, tacticalOnly);
+    }
+}
+
+// Génère tous les coups pseudo-légaux puis filtre les illégaux (clouages et échecs)
+// Sens des pions, rangée de promotion et cases du roque sont des constantes de Side<Us> :
+// chaque couleur a son générateur, sans test de couleur dans les boucles
+template <Color Us>
+void AIPlayer::generateMoves(Board& board, PackedMoveList& moves, bool tacticalOnly) const {
+    using S = Side<Us>;
+    moves.clear();
     
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            const Piece& piece = board.getPiece(row, col);
-            if (piece.isEmpty()) continue;
-            
-            int value = getPieceValue(piece.getType());
-            int bonus = getPositionBonus({row, col}, piece.getType(), piece.getColor());
-            
-            if (piece.getColor() == aiColor) {
-                score += value + bonus;
-            } else {
-                score -= value + bonus;
+    // Échecs et clouages calculés une fois : chaque coup est ensuite validé sans être joué
+    LegalityInfo info = board.legalityInfo<Us>();
+    Bitboard occupied = board.getOccupied();
+    Bitboard empty = ~occupied;
+    Bitboard enemies = board.getPieces(S::THEM);
+    Bitboard targets = tacticalOnly ? enemies : ~board.getPieces(Us);
+    
+    // Pions, toute la rangée d'un coup : avances (seulement les promotions en quiescence),
+    // puis prises vers chaque côté et prise en passant
+    Bitboard pawns = board.getPieces(Us, PieceType::Pawn);
+    Bitboard single = shift<S::PUSH>(pawns) & empty;
+    if (tacticalOnly) {
+        addPawnMoves<Us, S::PUSH>(moves, single & S::PROMOTION_RANK, PackedMove::Quiet);
+    } else {
+        addPawnMoves<Us, S::PUSH>(moves, single, PackedMove::Quiet);
+        addPawnMoves<Us, 2 * S::PUSH>(moves, shift<S::PUSH>(single & S::DOUBLE_PUSH_RANK) & empty,
+                                      PackedMove::Quiet);
+    }
+    addPawnMoves<Us, S::PUSH - 1>(moves, shift<S::PUSH - 1>(pawns & ~FILE_A) & enemies, PackedMove::Capture);
+    addPawnMoves<Us, S::PUSH + 1>(moves, shift<S::PUSH + 1>(pawns & ~FILE_H) & enemies, PackedMove::Capture);
+    
+    Position enPassant = board.getEnPassantTarget();
+    if (enPassant.isValid()) {
+        int to = squareIndex(enPassant);
+        Bitboard takers = Attacks::PAWN[Side<S::THEM>::INDEX][to] & pawns;
+        while (takers) {
+            moves.push_back(PackedMove(popLsb(takers), to, PackedMove::EnPassant));
+        }
+    }
+    
+    // Pièces : cases atteintes lues dans les tables d'attaques précalculées
+    Bitboard knights = board.getPieces(Us, PieceType::Knight);
+    while (knights) {
+        int sq = popLsb(knights);
+        addTargets(moves, sq, Attacks::knight(sq) & targets, enemies);
+    }
+    Bitboard bishops = board.getPieces(Us, PieceType::Bishop);
+    while (bishops) {
+        int sq = popLsb(bishops);
+        addTargets(moves, sq, Attacks::bishop(sq, occupied) & targets, enemies);
+    }
+    Bitboard rooks = board.getPieces(Us, PieceType::Rook);
+    while (rooks) {
+        int sq = popLsb(rooks);
+        addTargets(moves, sq, Attacks::rook(sq, occupied) & targets, enemies);
+    }
+    Bitboard queens = board.getPieces(Us, PieceType::Queen);
+    while (queens) {
+        int sq = popLsb(queens);
+        addTargets(moves, sq, Attacks::queen(sq, occupied) & targets, enemies);
+    }
+    
+    if (info.kingSq >= 0) {
+        addTargets(moves, info.kingSq, Attacks::king(info.kingSq) & targets, enemies);
+        
+        // Roque : droits, roi et tour jamais déplacés, chemin libre et non attaqué
+        if (!tacticalOnly && !info.checkers && info.kingSq == S::KING_START &&
+            !board.getPiece(S::KING_START).hasMoved()) {
+            const Piece& kingsideRook = board.getPiece(S::KING_START + 3);
+            if (board.canCastleKingside(Us) && !(occupied & S::KINGSIDE_EMPTY) &&
+                kingsideRook.getType() == PieceType::Rook && !kingsideRook.hasMoved() &&
+                !board.attackersTo<S::THEM>(S::KINGSIDE_PATH[0], occupied) &&
+                !board.attackersTo<S::THEM>(S::KINGSIDE_PATH[1], occupied)) {
+                moves.push_back(PackedMove(S::KING_START, S::KINGSIDE_PATH[1], PackedMove::KingCastle));
+            }
+            const Piece& queensideRook = board.getPiece(S::KING_START - 4);
+            if (board.canCastleQueenside(Us) && !(occupied & S::QUEENSIDE_EMPTY) &&
+                queensideRook.getType() == PieceType::Rook && !queensideRook.hasMoved() &&
+                !board.attackersTo<S::THEM>(S::QUEENSIDE_PATH[0], occupied) &&
+                !board.attackersTo<S::THEM>(S::QUEENSIDE_PATH[1], occupied)) {
+                moves.push_back(PackedMove(S::KING_START, S::QUEENSIDE_PATH[1], PackedMove::QueenCastle));
             }
         }
     }
     
+    // Filtrer sur place : garder seulement les coups qui ne laissent pas le roi en échec
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        if (board.isLegal<Us>(moves[i], info)) {
+            moves[kept++] = moves[i];
+        }
+    }
+    moves.resize(kept);
+}
+
+std::uint64_t AIPlayer::perft(Board& board, int depth) const {
+    if (depth == 0) return 1;
+    
+    PackedMoveList moves;
+    generateMoves(board, board.getSideToMove(), moves);
+    if (depth == 1) return moves.size();
+    
+    std::uint64_t nodes = 0;
+    for (PackedMove move : moves) {
+        MoveRecord record = board.applyMove(move);
+        nodes += perft(board, depth - 1);
+        board.revertMove(record);
+    }
+    return nodes;
+}
+
+MoveRecord AIPlayer::playMove(SearchThread& thread, PackedMove move) const {
+    MoveRecord record = thread.board.applyMove(move);
+    // Prise ou coup de pion : les positions précédentes ne peuvent plus revenir
+    bool irreversible = record.movedPiece.getType() == PieceType::Pawn || !record.capturedPiece.isEmpty();
+    thread.keys.push_back({thread.board.getHash(), irreversible ? 0 : thread.keys.back().halfmoveClock + 1});
+    return record;
+}
+
+void AIPlayer::takeBack(SearchThread& thread, const MoveRecord& record) const {
+    thread.board.revertMove(record);
+    thread.keys.pop_back();
+}
+
+// Le coup nul coupe la fenêtre : une position d'avant le coup nul n'y compte pas
+MoveRecord AIPlayer::playNullMove(SearchThread& thread) const {
+    MoveRecord record = thread.board.applyNullMove();
+    thread.keys.push_back({thread.board.getHash(), 0});
+    return record;
+}
+
+void AIPlayer::takeBackNullMove(SearchThread& thread, const MoveRecord& record) const {
+    thread.board.revertNullMove(record);
+    thread.keys.pop_back();
+}
+
+// Une seule répétition suffit dans l'arbre : si elle est bonne pour un camp, l'autre
+// peut la reproduire, le résultat n'est donc pas meilleur qu'une nulle
+bool AIPlayer::isDraw(const SearchThread& thread) const {
+    const auto& keys = thread.keys;
+    const KeyEntry& current = keys.back();
+    if (current.halfmoveClock >= 100) return true;
+    
+    // Même camp au trait et au moins deux coups de chaque côté pour revenir à la position
+    int last = static_cast<int>(keys.size()) - 1;
+    int first = std::max(0, last - current.halfmoveClock);
+    for (int i = last - 4; i >= first; i -= 2) {
+        if (keys[i].hash == current.hash) return true;
+    }
+    return false;
+}
+
+// Scores de mat et gains des tables de finales, qui dépendent tous deux de la distance
+// à la racine, stockés relativement au nœud courant dans la table de transposition
+static constexpr int TT_DISTANCE_SCORE = AIPlayer::TB_WIN_SCORE - AIPlayer::MAX_PLY;
+
+static int scoreToTT(int score, int ply) {
+    if (score > TT_DISTANCE_SCORE) return score + ply;
+    if (score < -TT_DISTANCE_SCORE) return score - ply;
     return score;
 }
 
-// Vérifie si une case est attaquée par une couleur sur un board donné
-bool AIPlayer::isAttacked(const Board& board, const Position& pos, Color byColor) const {
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            const Piece& piece = board.getPiece(row, col);
-            if (piece.isEmpty() || piece.getColor() != byColor) continue;
-            
-            int rowDiff = pos.row - row;
-            int colDiff = pos.col - col;
-            int absRow = std::abs(rowDiff);
-            int absCol = std::abs(colDiff);
-            
-            switch (piece.getType()) {
-                case PieceType::Pawn: {
-                    int dir = (byColor == Color::White) ? -1 : 1;
-                    if (rowDiff == dir && absCol == 1) return true;
-                    break;
-                }
-                case PieceType::Knight:
-                    if ((absRow == 2 && absCol == 1) || (absRow == 1 && absCol == 2))
-                        return true;
-                    break;
-                case PieceType::Bishop: {
-                    if (absRow == absCol && absRow > 0) {
-                        int rs = (rowDiff > 0) ? 1 : -1;
-                        int cs = (colDiff > 0) ? 1 : -1;
-                        bool clear = true;
-                        for (int i = 1; i < absRow; ++i) {
-                            if (!board.getPiece(row + i * rs, col + i * cs).isEmpty()) {
-                                clear = false; break;
-                            }
-                        }
-                        if (clear) return true;
-                    }
-                    break;
-                }
-                case PieceType::Rook: {
-                    if ((rowDiff == 0 || colDiff == 0) && (absRow + absCol > 0)) {
-                        int rs = (rowDiff == 0) ? 0 : (rowDiff > 0 ? 1 : -1);
-                        int cs = (colDiff == 0) ? 0 : (colDiff > 0 ? 1 : -1);
-                        int steps = std::max(absRow, absCol);
-                        bool clear = true;
-                        for (int i = 1; i < steps; ++i) {
-                            if (!board.getPiece(row + i * rs, col + i * cs).isEmpty()) {
-                                clear = false; break;
-                            }
-                        }
-                        if (clear) return true;
-                    }
-                    break;
-                }
-                case PieceType::Queen: {
-                    bool diag = (absRow == absCol && absRow > 0);
-                    bool straight = ((rowDiff == 0 || colDiff == 0) && (absRow + absCol > 0));
-                    if (diag || straight) {
-                        int rs = (rowDiff == 0) ? 0 : (rowDiff > 0 ? 1 : -1);
-                        int cs = (colDiff == 0) ? 0 : (colDiff > 0 ? 1 : -1);
-                        int steps = std::max(absRow, absCol);
-                        bool clear = true;
-                        for (int i = 1; i < steps; ++i) {
-                            if (!board.getPiece(row + i * rs, col + i * cs).isEmpty()) {
-                                clear = false; break;
-                            }
-                        }
-                        if (clear) return true;
-                    }
-                    break;
-                }
-                case PieceType::King:
-                    if (absRow <= 1 && absCol <= 1 && (absRow + absCol > 0))
-                        return true;
-                    break;
-                default: break;
-            }
+static int scoreFromTT(int score, int ply) {
+    if (score > TT_DISTANCE_SCORE) return score - ply;
+    if (score < -TT_DISTANCE_SCORE) return score + ply;
+    return score;
+}
+
+// Paliers de l'ordre des coups : variation principale, coup de la table, prises (MVV-LVA)
+// et promotions, coups meurtriers, puis coups calmes selon l'historique
+static constexpr int PV_MOVE_SCORE = 4000000;
+static constexpr int TT_MOVE_SCORE = 3000000;
+static constexpr int CAPTURE_SCORE = 2000000;
+static constexpr int KILLER_SCORE = 1000000;
+static constexpr int HISTORY_MAX = 500000;
+
+void AIPlayer::scoreMoves(const SearchThread& thread, const Board& board, const PackedMoveList& moves,
+                          int* scores, PackedMove ttMove, PackedMove pvMove, int ply) const {
+    int side = colorIndex(board.getSideToMove());
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        PackedMove move = moves[i];
+        if (!pvMove.isNull() && move == pvMove) {
+            scores[i] = PV_MOVE_SCORE;
+        } else if (!ttMove.isNull() && move == ttMove) {
+            scores[i] = TT_MOVE_SCORE;
+        } else if (move.isCapture() || move.isPromotion()) {
+            // Victime la plus chère d'abord, puis attaquant le moins cher
+            PieceType victim = move.isEnPassant() ? PieceType::Pawn : board.getPiece(move.to()).getType();
+            PieceType attacker = board.getPiece(move.from()).getType();
+            scores[i] = CAPTURE_SCORE + 10 * getPieceValue(victim) - typeIndex(attacker)
+                      + (move.isPromotion() ? getPieceValue(move.promotion()) : 0);
+        } else if (move == thread.killers[ply][0]) {
+            scores[i] = KILLER_SCORE + 1;
+        } else if (move == thread.killers[ply][1]) {
+            scores[i] = KILLER_SCORE;
+        } else {
+            scores[i] = thread.history[side][move.from()][move.to()];
         }
     }
-    return false;
 }
 
-bool AIPlayer::isInCheck(const Board& board, Color color) const {
-    Position kingPos = board.findKing(color);
-    if (!kingPos.isValid()) return true; // Roi absent = considéré en échec
-    Color opponent = (color == Color::White) ? Color::Black : Color::White;
-    return isAttacked(board, kingPos, opponent);
+// Tri par sélection paresseux : amène le meilleur coup restant en position index,
+// la plupart des nœuds coupant après un ou deux coups
+static void pickMove(PackedMoveList& moves, int* scores, std::size_t index) {
+    std::size_t best = index;
+    for (std::size_t i = index + 1; i < moves.size(); ++i) {
+        if (scores[i] > scores[best]) best = i;
+    }
+    if (best != index) {
+        std::swap(moves[index], moves[best]);
+        std::swap(scores[index], scores[best]);
+    }
 }
 
-// Simule un coup sur le board (modifie le board passé par référence)
-// Retourne false si le coup laisse le roi en échec
-bool AIPlayer::simulateMove(Board& board, const Move& move, Color currentTurn) const {
-    // En passant : capturer le pion
-    if (move.isEnPassant) {
-        board.removePiece({move.from.row, move.to.col});
+// Un coup calme qui provoque une coupure est retenu pour les positions sœurs (même ply)
+// et renforcé dans l'historique, d'autant plus que la recherche était profonde
+void AIPlayer::updateQuietCutoff(SearchThread& thread, const Board& board, PackedMove move, int depth, int ply) {
+    if (thread.killers[ply][0] != move) {
+        thread.killers[ply][1] = thread.killers[ply][0];
+        thread.killers[ply][0] = move;
     }
     
-    // Roque : déplacer la tour aussi
-    if (move.isCastling) {
-        board.movePiece(move.from, move.to);
-        int rookFromCol = (move.to.col > move.from.col) ? 7 : 0;
-        int rookToCol = (move.to.col > move.from.col) ? 5 : 3;
-        board.movePiece({move.from.row, rookFromCol}, {move.from.row, rookToCol});
+    int& entry = thread.history[colorIndex(board.getSideToMove())][move.from()][move.to()];
+    entry += depth * depth;
+    if (entry > HISTORY_MAX) {
+        for (auto& side : thread.history) {
+            for (auto& from : side) {
+                for (int& value : from) value /= 2;
+            }
+        }
+    }
+}
+
+// Échange statique sur la case d'arrivée : chaque camp reprend avec sa pièce la moins
+// chère (rayons X compris) et peut s'arrêter quand continuer lui ferait perdre du matériel
+int AIPlayer::staticExchange(const Board& board, PackedMove move) const {
+    int to = move.to();
+    Color side = board.getPiece(move.from()).getColor();
+    Bitboard occupied = board.getOccupied() ^ squareBit(move.from());
+    
+    int gain[32];
+    int depth = 0;
+    if (move.isEnPassant()) {
+        occupied ^= squareBit(squareIndex(squarePosition(move.from()).row, squarePosition(to).col));
+        gain[0] = getPieceValue(PieceType::Pawn);
     } else {
-        board.movePiece(move.from, move.to);
+        gain[0] = getPieceValue(board.getPiece(to).getType());
     }
     
-    // Promotion
-    if (move.promotion != PieceType::None) {
-        Piece promoted(move.promotion, currentTurn);
-        promoted.setMoved(true);
-        board.setPiece(move.to, promoted);
+    // Pièce qui se trouve maintenant sur la case et peut être prise à son tour
+    PieceType onSquare = board.getPiece(move.from()).getType();
+    if (move.isPromotion()) {
+        gain[0] += getPieceValue(move.promotion()) - getPieceValue(PieceType::Pawn);
+        onSquare = move.promotion();
     }
     
-    // En passant target pour le prochain coup
-    board.clearEnPassantTarget();
-    const Piece& movedPiece = board.getPiece(move.to);
-    if (movedPiece.getType() == PieceType::Pawn) {
-        if (std::abs(move.to.row - move.from.row) == 2) {
-            board.setEnPassantTarget({(move.from.row + move.to.row) / 2, move.from.col});
+    side = opponentOf(side);
+    while (depth < 31) {
+        Bitboard attackers = board.attackersTo(to, side, occupied) & occupied;
+        if (!attackers) break;
+        
+        int from = -1;
+        PieceType attacker = PieceType::None;
+        for (int t = typeIndex(PieceType::Pawn); t <= typeIndex(PieceType::King); ++t) {
+            Bitboard pieces = attackers & board.getPieces(side, static_cast<PieceType>(t));
+            if (pieces) {
+                from = lsb(pieces);
+                attacker = static_cast<PieceType>(t);
+                break;
+            }
+        }
+        
+        ++depth;
+        gain[depth] = getPieceValue(onSquare) - gain[depth - 1];
+        // Le camp au trait perd du matériel qu'il prenne ou non : le signe du résultat
+        // est acquis (seul le signe sert à la recherche), on arrête l'échange ici
+        if (std::max(-gain[depth - 1], gain[depth]) < 0) {
+            --depth;
+            break;
         }
+        
+        occupied ^= squareBit(from);
+        onSquare = attacker;
+        side = opponentOf(side);
     }
     
-    // Vérifier si le roi est en échec après le coup
-    if (isInCheck(board, currentTurn)) {
-        return false; // Coup illégal
+    for (; depth > 0; --depth) {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
     }
-    
-    return true;
+    return gain[0];
 }
 
-// Génère tous les coups pseudo-légaux puis filtre les illégaux (via copie)
-std::vector<Move> AIPlayer::generateMoves(const Board& board, Color color) const {
-    std::vector<Move> legalMoves;
+// Quiescence : seulement les prises et promotions, avec la possibilité de ne rien jouer
+// (stand pat) ; en échec toutes les parades sont examinées
+template <Color Us>
+int AIPlayer::quiescence(SearchThread& thread, int ply, int alpha, int beta) {
+    Board& board = thread.board;
+    thread.pvLength[ply] = ply;
+    if (m_stopSearch) return 0;
+    ++thread.qnodes;
+    if ((thread.countNode() & 1023) == 0 && thread.isMain) checkTime();
     
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            const Piece& piece = board.getPiece(row, col);
-            if (piece.isEmpty() || piece.getColor() != color) continue;
-            
-            Position from = {row, col};
-            std::vector<Move> pseudoMoves;
-            
-            switch (piece.getType()) {
-                case PieceType::Pawn: {
-                    int dir = (color == Color::White) ? -1 : 1;
-                    int startRow = (color == Color::White) ? 6 : 1;
-                    int promoRow = (color == Color::White) ? 0 : 7;
-                    
-                    // Avance simple
-                    Position fwd = {row + dir, col};
-                    if (fwd.isValid() && board.getPiece(fwd).isEmpty()) {
-                        if (fwd.row == promoRow) {
-                            pseudoMoves.push_back({from, fwd, PieceType::Queen, false, false, false});
-                        } else {
-                            pseudoMoves.push_back({from, fwd});
-                        }
-                        // Avance double
-                        if (row == startRow) {
-                            Position fwd2 = {row + 2 * dir, col};
-                            if (board.getPiece(fwd2).isEmpty()) {
-                                pseudoMoves.push_back({from, fwd2});
-                            }
-                        }
-                    }
-                    // Captures
-                    for (int dc : {-1, 1}) {
-                        Position cap = {row + dir, col + dc};
-                        if (!cap.isValid()) continue;
-                        const Piece& target = board.getPiece(cap);
-                        bool isCapture = !target.isEmpty() && target.getColor() != color;
-                        bool isEP = (cap == board.getEnPassantTarget());
-                        if (isCapture || isEP) {
-                            if (cap.row == promoRow) {
-                                pseudoMoves.push_back({from, cap, PieceType::Queen, true, false, false});
-                            } else {
-                                pseudoMoves.push_back({from, cap, PieceType::None, isCapture, false, isEP});
-                            }
-                        }
-                    }
-                    break;
-                }
-                case PieceType::Knight: {
-                    int offsets[][2] = {{-2,-1},{-2,1},{-1,-2},{-1,2},{1,-2},{1,2},{2,-1},{2,1}};
-                    for (auto& o : offsets) {
-                        Position to = {row + o[0], col + o[1]};
-                        if (!to.isValid()) continue;
-                        const Piece& t = board.getPiece(to);
-                        if (t.isEmpty() || t.getColor() != color) {
-                            pseudoMoves.push_back({from, to, PieceType::None, !t.isEmpty()});
-                        }
-                    }
-                    break;
-                }
-                case PieceType::Bishop: {
-                    int dirs[][2] = {{-1,-1},{-1,1},{1,-1},{1,1}};
-                    for (auto& d : dirs) {
-                        Position to = from;
-                        while (true) {
-                            to = {to.row + d[0], to.col + d[1]};
-                            if (!to.isValid()) break;
-                            const Piece& t = board.getPiece(to);
-                            if (t.isEmpty()) {
-                                pseudoMoves.push_back({from, to});
-                            } else {
-                                if (t.getColor() != color)
-                                    pseudoMoves.push_back({from, to, PieceType::None, true});
-                                break;
-                            }
-                        }
-                    }
-                    break;
-                }
-                case PieceType::Rook: {
-                    int dirs[][2] = {{-1,0},{1,0},{0,-1},{0,1}};
-                    for (auto& d : dirs) {
-                        Position to = from;
-                        while (true) {
-                            to = {to.row + d[0], to.col + d[1]};
-                            if (!to.isValid()) break;
-                            const Piece& t = board.getPiece(to);
-                            if (t.isEmpty()) {
-                                pseudoMoves.push_back({from, to});
-                            } else {
-                                if (t.getColor() != color)
-                                    pseudoMoves.push_back({from, to, PieceType::None, true});
-                                break;
-                            }
-                        }
-                    }
-                    break;
-                }
-                case PieceType::Queen: {
-                    int dirs[][2] = {{-1,-1},{-1,0},{-1,1},{0,-1},{0,1},{1,-1},{1,0},{1,1}};
-                    for (auto& d : dirs) {
-                        Position to = from;
-                        while (true) {
-                            to = {to.row + d[0], to.col + d[1]};
-                            if (!to.isValid()) break;
-                            const Piece& t = board.getPiece(to);
-                            if (t.isEmpty()) {
-                                pseudoMoves.push_back({from, to});
-                            } else {
-                                if (t.getColor() != color)
-                                    pseudoMoves.push_back({from, to, PieceType::None, true});
-                                break;
-                            }
-                        }
-                    }
-                    break;
-                }
-                case PieceType::King: {
-                    for (int dr = -1; dr <= 1; ++dr) {
-                        for (int dc = -1; dc <= 1; ++dc) {
-                            if (dr == 0 && dc == 0) continue;
-                            Position to = {row + dr, col + dc};
-                            if (!to.isValid()) continue;
-                            const Piece& t = board.getPiece(to);
-                            if (t.isEmpty() || t.getColor() != color) {
-                                pseudoMoves.push_back({from, to, PieceType::None, !t.isEmpty()});
-                            }
-                        }
-                    }
-                    // Roque (simplifié : vérifier droits et chemin libre)
-                    if (!piece.hasMoved() && !isInCheck(board, color)) {
-                        Color opp = (color == Color::White) ? Color::Black : Color::White;
-                        // Petit roque
-                        if (board.canCastleKingside(color)) {
-                            const Piece& rook = board.getPiece(row, 7);
-                            if (rook.getType() == PieceType::Rook && !rook.hasMoved() &&
-                                board.getPiece(row, 5).isEmpty() && board.getPiece(row, 6).isEmpty() &&
-                                !isAttacked(board, {row, 5}, opp) && !isAttacked(board, {row, 6}, opp)) {
-                                pseudoMoves.push_back({from, {row, 6}, PieceType::None, false, true, false});
-                            }
-                        }
-                        // Grand roque
-                        if (board.canCastleQueenside(color)) {
-                            const Piece& rook = board.getPiece(row, 0);
-                            if (rook.getType() == PieceType::Rook && !rook.hasMoved() &&
-                                board.getPiece(row, 1).isEmpty() && board.getPiece(row, 2).isEmpty() &&
-                                board.getPiece(row, 3).isEmpty() &&
-                                !isAttacked(board, {row, 2}, opp) && !isAttacked(board, {row, 3}, opp)) {
-                                pseudoMoves.push_back({from, {row, 2}, PieceType::None, false, true, false});
-                            }
-                        }
-                    }
-                    break;
-                }
-                default: break;
-            }
-            
-            // Filtrer : garder seulement les coups qui ne laissent pas le roi en échec
-            for (const Move& m : pseudoMoves) {
-                Board copy = board; // Copie du board
-                if (simulateMove(copy, m, color)) {
-                    legalMoves.push_back(m);
-                }
+    if (ply >= MAX_PLY - 1) {
+        return evaluateBoard(board, Us);
+    }
+    
+    bool inCheck = isInCheck<Us>(board);
+    int bestScore = -INFINITY_SCORE;
+    if (!inCheck) {
+        bestScore = evaluateBoard(board, Us);
+        if (bestScore >= beta) return bestScore;
+        alpha = std::max(alpha, bestScore);
+    }
+    
+    PackedMoveList moves;
+    generateMoves<Us>(board, moves, !inCheck);
+    if (inCheck && moves.empty()) {
+        return -MATE_SCORE + ply;
+    }
+    int scores[PackedMoveList::capacity()];
+    scoreMoves(thread, board, moves, scores, PackedMove(), PackedMove(), ply);
+    
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        pickMove(moves, scores, i);
+        PackedMove move = moves[i];
+        // Les prises perdantes ne changent pas le résultat d'une position calme
+        if (!inCheck && !move.isPromotion() && staticExchange(board, move) < 0) continue;
+        
+        MoveRecord record = playMove(thread, move);
+        int score = -quiescence<Side<Us>::THEM>(thread, ply + 1, -beta, -alpha);
+        takeBack(thread, record);
+        if (m_stopSearch) return 0;
+        
+        if (score > bestScore) {
+            bestScore = score;
+        }
+        if (score > alpha) {
+            alpha = score;
+            thread.pvTable[ply][ply] = move;
+            for (int j = ply + 1; j < thread.pvLength[ply + 1]; ++j) {
+                thread.pvTable[ply][j] = thread.pvTable[ply + 1][j];
             }
+            thread.pvLength[ply] = thread.pvLength[ply + 1];
+        }
+        if (alpha >= beta) {
+            ++thread.cutoffs;
+            if (i == 0) ++thread.firstMoveCutoffs;
+            break;
         }
     }
     
-    return legalMoves;
+    return bestScore;
 }
 
-// Minimax avec alpha-beta — travaille UNIQUEMENT sur des copies
-int AIPlayer::minimax(Board board, Color currentTurn, int depth, int alpha, int beta,
-                      bool maximizing, Color aiColor) {
+// Recherche sélective : coup nul R = 2 + profondeur / 4, réductions des coups tardifs
+// croissant avec la profondeur et le rang du coup, marges de futilité par profondeur
+static constexpr int NULL_MOVE_MIN_DEPTH = 3;
+static constexpr int NULL_MOVE_REDUCTION = 2;
+static constexpr int LMR_MIN_DEPTH = 3;
+static constexpr int LMR_MIN_MOVES = 3;
+static constexpr int FUTILITY_MAX_DEPTH = 2;
+static constexpr int FUTILITY_MARGIN[FUTILITY_MAX_DEPTH + 1] = {0, 200, 450};
+
+static int lateMoveReduction(int depth, int moveNumber) {
+    static const auto table = [] {
+        std::array<std::array<int, 64>, AIPlayer::MAX_PLY> reductions{};
+        for (int d = 1; d < AIPlayer::MAX_PLY; ++d) {
+            for (int m = 1; m < 64; ++m) {
+                reductions[d][m] = std::max(1, static_cast<int>(0.5 + std::log(d) * std::log(m) / 2.0));
+            }
+        }
+        return reductions;
+    }();
+    return table[std::min(depth, AIPlayer::MAX_PLY - 1)][std::min(moveNumber, 63)];
+}
+
+// Minimax (forme negamax) avec alpha-beta et table de transposition
+// Joue et annule les coups en place ; le score est du point de vue du joueur au trait
+template <Color Us>
+int AIPlayer::minimax(SearchThread& thread, int depth, int ply, int alpha, int beta, bool allowNull) {
+    Board& board = thread.board;
+    thread.pvLength[ply] = ply;
+    if (m_stopSearch) return 0;
+    // Seul le thread principal surveille la pendule
+    if ((thread.countNode() & 1023) == 0 && thread.isMain) checkTime();
+    
+    // Position déjà vue (dans la partie ou sur le chemin) ou 50 coups : nulle, sans chercher.
+    // Seule exception, comme dans ChessLogic::getGameState : le coup qui atteint les 50 coups
+    // mate, et le mat l'emporte
+    if (isDraw(thread)) {
+        if (thread.keys.back().halfmoveClock >= 100 && isInCheck<Us>(board)) {
+            PackedMoveList evasions;
+            generateMoves<Us>(board, evasions);
+            if (evasions.empty()) return -MATE_SCORE + ply;
+        }
+        return 0;
+    }
+    
+    std::uint64_t key = board.getHash();
+    int alphaOrig = alpha;
+    
+    // Sonder la table de transposition
+    TTEntry entry;
+    bool ttHit = m_tt.probe(key, entry);
+    ++thread.ttProbes;
+    if (ttHit) ++thread.ttHits;
+    if (ttHit && entry.depth >= depth) {
+        int ttScore = scoreFromTT(entry.score, ply);
+        if (entry.bound == Bound::Exact) return ttScore;
+        if (entry.bound == Bound::Lower && ttScore >= beta) return ttScore;
+        if (entry.bound == Bound::Upper && ttScore <= alpha) return ttScore;
+    }
+    
+    // Finale présente dans les tables : résultat exact sans chercher plus loin. Les WDL
+    // supposent un compteur des 50 coups nul : on ne sonde donc que juste après une prise
+    // ou un coup de pion (pas derrière un coup nul, qui remet aussi le compteur de la pile à
+    // zéro), et pas aux feuilles (la quiescence suit, inutile de payer le sondage)
+    Tablebase::Wdl wdl;
+    if (depth > 0 && allowNull && thread.keys.back().halfmoveClock == 0 && m_tbPieceLimit > 0 &&
+        Tablebase::canProbe(board, m_tbPieceLimit) && Tablebase::probeWdl(board, wdl)) {
+        ++thread.tbHits;
+        int score = wdl == Tablebase::Wdl::Win  ? TB_WIN_SCORE - ply
+                  : wdl == Tablebase::Wdl::Loss ? -TB_WIN_SCORE + ply
+                                                : 0;
+        m_tt.store(key, depth, Bound::Exact, scoreToTT(score, ply), PackedMove());
+        return score;
+    }
+    
+    // Profondeur 0 : on ne s'arrête qu'une fois la position calme
+    if (depth <= 0) {
+        return quiescence<Us>(thread, ply, alpha, beta);
+    }
+    
+    // Hors variation principale la fenêtre est nulle : seules ces positions sont élaguées
+    bool pvNode = beta - alpha > 1;
+    bool inCheck = isInCheck<Us>(board);
+    int staticEval = inCheck ? -INFINITY_SCORE : evaluateBoard(board, Us);
+    
+    // Coup nul : si passer son tour tient encore beta, le meilleur vrai coup aussi.
+    // Jamais en échec ni avec seulement des pions, où le zugzwang fausse l'hypothèse
+    Bitboard pieces = board.getPieces(Us) & ~board.getPieces(Us, PieceType::Pawn) &
+                      ~board.getPieces(Us, PieceType::King);
+    if (m_features.nullMove && allowNull && !pvNode && !inCheck && pieces &&
+        depth >= NULL_MOVE_MIN_DEPTH && staticEval >= beta && ply < MAX_PLY - 1) {
+        MoveRecord record = playNullMove(thread);
+        int score = -minimax<Side<Us>::THEM>(thread, depth - 1 - NULL_MOVE_REDUCTION - depth / 4, ply + 1,
+                                             -beta, -beta + 1, false);
+        takeBackNullMove(thread, record);
+        if (m_stopSearch) return 0;
+        if (score >= beta) {
+            // Un mat trouvé derrière un coup nul n'est pas démontré
+            return score >= TB_WIN_SCORE - MAX_PLY ? beta : score;
+        }
+    }
+    
     // Générer les coups pour le joueur courant
-    std::vector<Move> moves = generateMoves(board, currentTurn);
-    Color opponent = (currentTurn == Color::White) ? Color::Black : Color::White;
+    PackedMoveList moves;
+    generateMoves<Us>(board, moves);
     
     // Pas de coups légaux
     if (moves.empty()) {
-        if (isInCheck(board, currentTurn)) {
-            // Mat
-            return maximizing ? (-100000 + (getMaxDepth() - depth))
-                              : (100000 - (getMaxDepth() - depth));
+        if (inCheck) {
+            return -MATE_SCORE + ply; // Mat
         }
         return 0; // Pat
     }
     
-    // Profondeur 0 : évaluation statique
-    if (depth == 0) {
-        return evaluateBoard(board, aiColor);
+    if (ply >= MAX_PLY - 1) {
+        return evaluateBoard(board, Us);
     }
     
-    // Trier les coups : captures d'abord (simple heuristique)
-    std::sort(moves.begin(), moves.end(), [&](const Move& a, const Move& b) {
-        int scoreA = 0, scoreB = 0;
-        if (a.isCapture || !board.getPiece(a.to).isEmpty()) {
-            scoreA += 10 * getPieceValue(board.getPiece(a.to).getType());
+    int scores[PackedMoveList::capacity()];
+    scoreMoves(thread, board, moves, scores, ttHit ? entry.move : PackedMove(), followPvMove(thread, moves, ply), ply);
+    
+    // Près des feuilles, un coup calme ne comble pas un retard plus grand que la marge
+    bool futile = m_features.futility && !pvNode && !inCheck && depth <= FUTILITY_MAX_DEPTH &&
+                  std::abs(alpha) < TB_WIN_SCORE - MAX_PLY && staticEval + FUTILITY_MARGIN[depth] <= alpha;
+    
+    int bestScore = -INFINITY_SCORE;
+    PackedMove bestMove = moves[0];
+    int searched = 0;
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        pickMove(moves, scores, i);
+        PackedMove move = moves[i];
+        bool quiet = !move.isCapture() && !move.isPromotion();
+        MoveRecord record = playMove(thread, move);
+        bool givesCheck = isInCheck<Side<Us>::THEM>(board);
+        
+        // Le premier coup est toujours cherché : il reste un score et un meilleur coup.
+        // Un coup écarté peut valoir jusqu'à l'évaluation plus la marge : la borne
+        // supérieure stockée en cas d'échec bas ne doit pas descendre en dessous
+        if (futile && quiet && !givesCheck && searched > 0) {
+            takeBack(thread, record);
+            bestScore = std::max(bestScore, staticEval + FUTILITY_MARGIN[depth]);
+            continue;
         }
-        if (a.promotion != PieceType::None) scoreA += 900;
-        if (b.isCapture || !board.getPiece(b.to).isEmpty()) {
-            scoreB += 10 * getPieceValue(board.getPiece(b.to).getType());
+        
+        int score;
+        if (searched == 0) {
+            score = -minimax<Side<Us>::THEM>(thread, depth - 1, ply + 1, -beta, -alpha);
+        } else {
+            // Coups calmes tardifs (ni coup de table, ni coup meurtrier) : profondeur réduite
+            int reduction = 0;
+            if (m_features.lateMoveReductions && quiet && !inCheck && !givesCheck &&
+                depth >= LMR_MIN_DEPTH && searched >= LMR_MIN_MOVES && scores[i] < KILLER_SCORE) {
+                reduction = std::min(lateMoveReduction(depth, searched), depth - 2);
+            }
+            
+            // Fenêtre nulle : il suffit de savoir si le coup bat alpha, sinon on recherche
+            // à pleine profondeur puis avec la vraie fenêtre
+            score = -minimax<Side<Us>::THEM>(thread, depth - 1 - reduction, ply + 1, -alpha - 1, -alpha);
+            if (score > alpha && reduction > 0) {
+                score = -minimax<Side<Us>::THEM>(thread, depth - 1, ply + 1, -alpha - 1, -alpha);
+            }
+            if (score > alpha && score < beta) {
+                score = -minimax<Side<Us>::THEM>(thread, depth - 1, ply + 1, -beta, -alpha);
+            }
         }
-        if (b.promotion != PieceType::None) scoreB += 900;
-        return scoreA > scoreB;
-    });
-    
-    if (maximizing) {
-        int maxEval = std::numeric_limits<int>::min();
-        for (const Move& move : moves) {
-            Board copy = board; // Copie fraîche pour chaque coup
-            simulateMove(copy, move, currentTurn);
-            int eval = minimax(copy, opponent, depth - 1, alpha, beta, false, aiColor);
-            maxEval = std::max(maxEval, eval);
-            alpha = std::max(alpha, eval);
-            if (beta <= alpha) break;
-        }
-        return maxEval;
-    } else {
-        int minEval = std::numeric_limits<int>::max();
-        for (const Move& move : moves) {
-            Board copy = board;
-            simulateMove(copy, move, currentTurn);
-            int eval = minimax(copy, opponent, depth - 1, alpha, beta, true, aiColor);
-            minEval = std::min(minEval, eval);
-            beta = std::min(beta, eval);
-            if (beta <= alpha) break;
+        takeBack(thread, record);
+        ++searched;
+        
+        // Seul le premier coup peut encore suivre la variation précédente
+        thread.followPv = false;
+        if (m_stopSearch) return 0;
+        
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+        }
+        if (score > alpha) {
+            alpha = score;
+            thread.pvTable[ply][ply] = move;
+            for (int i = ply + 1; i < thread.pvLength[ply + 1]; ++i) {
+                thread.pvTable[ply][i] = thread.pvTable[ply + 1][i];
+            }
+            thread.pvLength[ply] = thread.pvLength[ply + 1];
+        }
+        if (alpha >= beta) {
+            ++thread.cutoffs;
+            if (i == 0) ++thread.firstMoveCutoffs;
+            if (quiet) {
+                updateQuietCutoff(thread, board, move, depth, ply);
+            }
+            break;
         }
-        return minEval;
     }
+    
+    Bound bound = (bestScore <= alphaOrig) ? Bound::Upper
+                : (bestScore >= beta)      ? Bound::Lower
+                                           : Bound::Exact;
+    m_tt.store(key, depth, bound, scoreToTT(bestScore, ply), bestMove);
+    
+    return bestScore;
 }
 
 int AIPlayer::getMaxDepth() const {
+    if (m_depthLimit > 0) {
+        return std::min(m_depthLimit, MAX_PLY - 1);
+    }
     switch (m_difficulty) {
         case AIDifficulty::Easy:   return 1;
         case AIDifficulty::Medium: return 2;
         case AIDifficulty::Hard:   return 3;
         case AIDifficulty::Expert: return 4;
+        case AIDifficulty::Master: return 8;
         default: return 2;
     }
 }
 
-Move AIPlayer::findBestMove(Color color) {
-    // Utiliser le vrai board pour obtenir les coups légaux via ChessLogic
-    // (on fait confiance à ChessLogic pour le premier niveau seulement)
-    std::vector<Move> moves = m_logic.getAllLegalMoves(color);
-    
-    if (moves.empty()) {
-        return Move{};
+int AIPlayer::computeTimeBudget() const {
+    if (m_moveTimeMs > 0) {
+        return m_moveTimeMs;
     }
+    if (m_remainingTimeMs > 0) {
+        // Environ 30 coups à jouer avec le temps restant
+        return std::max(1, m_remainingTimeMs / 30);
+    }
+    return 0;
+}
+
+int AIPlayer::elapsedMs() const {
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_searchStart).count());
+}
+
+void AIPlayer::checkTime() {
+    // La pendule ne tourne qu'à partir du ponderHit
+    if (m_pondering) return;
+    if (m_timeBudgetMs > 0 && clockMs() >= m_timeBudgetMs) {
+        m_stopSearch = true;
+    }
+}
+
+PackedMove AIPlayer::followPvMove(SearchThread& thread, const PackedMoveList& moves, int ply) {
+    if (!thread.followPv) return PackedMove();
     
-    int depth = getMaxDepth();
-    int bestScore = std::numeric_limits<int>::min();
-    std::vector<Move> bestMoves;
-    
-    Color opponent = (color == Color::White) ? Color::Black : Color::White;
+    if (ply >= static_cast<int>(thread.previousPv.size())) {
+        thread.followPv = false;
+        return PackedMove();
+    }
+    PackedMove pvMove = thread.previousPv[ply];
+    if (std::find(moves.begin(), moves.end(), pvMove) == moves.end()) {
+        thread.followPv = false;
+        return PackedMove();
+    }
+    return pvMove;
+}
+
+int AIPlayer::searchRoot(SearchThread& thread, PackedMoveList& moves, int depth, PackedMoveList& bestMoves) {
+    Board& board = thread.board;
+    Color color = board.getSideToMove();
+    int bestScore = -INFINITY_SCORE;
+    int alpha = -INFINITY_SCORE;
+    int beta = INFINITY_SCORE;
     
-    int alpha = std::numeric_limits<int>::min();
-    int beta = std::numeric_limits<int>::max();
+    bestMoves.clear();
+    thread.pvLength[0] = 0;
     
-    for (Move move : moves) {
-        // Toujours promouvoir en dame
-        if (move.promotion != PieceType::None) {
-            move.promotion = PieceType::Queen;
-        }
-        
-        // Créer une COPIE du board et simuler le coup dessus
-        Board boardCopy = m_board;
-        if (!simulateMove(boardCopy, move, color)) {
-            continue; // Coup illégal (ne devrait pas arriver)
-        }
+    for (PackedMove move : moves) {
+        MoveRecord record = playMove(thread, move);
         
         int score;
-        if (depth <= 1) {
-            // Pour Easy : évaluation directe
-            score = evaluateBoard(boardCopy, color);
+        thread.pvLength[1] = 1;
+        if (depth <= 1 && m_difficulty == AIDifficulty::Easy) {
+            // Easy : évaluation directe, sans voir les échanges
+            score = evaluateBoard(board, color);
         } else {
-            // Minimax sur la copie
-            score = minimax(boardCopy, opponent, depth - 1, alpha, beta, false, color);
+            // Fenêtre ouverte d'un point sous le meilleur score : un coup réfuté (coup nul,
+            // borne de la table, réduction) revient au plus à alpha - 1 et seul un coup
+            // réellement égal au meilleur rend exactement alpha, donc compte comme ex aequo
+            int lower = bestMoves.empty() ? alpha : alpha - 1;
+            // Le camp au trait est connu ici : la suite de l'arbre est spécialisée
+            score = color == Color::White ? -minimax<Color::Black>(thread, depth - 1, 1, -beta, -lower)
+                                          : -minimax<Color::White>(thread, depth - 1, 1, -beta, -lower);
         }
+        takeBack(thread, record);
+        thread.followPv = false;
+        
+        // Itération interrompue : son résultat est incomplet
+        if (m_stopSearch) break;
         
         if (score > bestScore) {
             bestScore = score;
             bestMoves.clear();
             bestMoves.push_back(move);
+            
+            thread.pvTable[0][0] = move;
+            for (int i = 1; i < thread.pvLength[1]; ++i) {
+                thread.pvTable[0][i] = thread.pvTable[1][i];
+            }
+            thread.pvLength[0] = thread.pvLength[1];
         } else if (score == bestScore) {
             bestMoves.push_back(move);
         }
@@ -551,13 +737,347 @@ Move AIPlayer::findBestMove(Color color) {
         alpha = std::max(alpha, score);
     }
     
-    if (bestMoves.empty()) {
-        return moves[0];
+    return bestScore;
+}
+
+Move AIPlayer::findBestMove(Color color) {
+    cancelSearch();
+    prepareSearch(color);
+    return runSearch();
+}
+
+void AIPlayer::startSearch(Color color) {
+    cancelSearch();
+    prepareSearch(color);
+    m_searchFuture = std::async(std::launch::async, [this] { return runSearch(); });
+}
+
+bool AIPlayer::isSearchDone() const {
+    return m_searchFuture.valid() &&
+           m_searchFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+Move AIPlayer::getSearchResult() {
+    if (!m_searchFuture.valid()) {
+        return Move{};
+    }
+    return m_searchFuture.get();
+}
+
+void AIPlayer::cancelSearch() {
+    m_pondering = false;
+    if (m_searchFuture.valid()) {
+        m_stopSearch = true;
+        m_searchFuture.wait();
+        m_searchFuture = std::future<Move>();
+    }
+}
+
+void AIPlayer::stopSearch() {
+    m_pondering = false;
+    m_stopSearch = true;
+}
+
+void AIPlayer::startPondering(Color color, const Move& expectedReply) {
+    cancelSearch();
+    // Position d'avant la réponse adverse, puis la réponse jouée sur chaque copie
+    prepareSearch(opponentOf(color));
+    for (auto& thread : m_threads) {
+        playMove(*thread, PackedMove::fromMove(expectedReply));
+    }
+    m_rootColor = color;
+    m_ponderMove = expectedReply;
+    m_timeBudgetMs = 0;
+    m_pondering = true;
+    m_searchFuture = std::async(std::launch::async, [this] { return runSearch(); });
+}
+
+bool AIPlayer::ponderHit(const Move& played) {
+    if (!m_pondering) return false;
+    
+    if (played != m_ponderMove) {
+        cancelSearch();
+        return false;
+    }
+    ponderHit();
+    return true;
+}
+
+void AIPlayer::startPondering(Color color) {
+    cancelSearch();
+    prepareSearch(color);
+    m_ponderMove = Move{};
+    m_timeBudgetMs = 0;
+    m_pondering = true;
+    m_searchFuture = std::async(std::launch::async, [this] { return runSearch(); });
+}
+
+void AIPlayer::ponderHit() {
+    if (!m_pondering) return;
+    
+    // Le budget du coup commence maintenant, après le temps déjà passé à réfléchir
+    m_clockStartMs = elapsedMs();
+    m_timeBudgetMs = computeTimeBudget();
+    m_pondering = false;
+}
+
+void AIPlayer::setThreadCount(int threads) {
+    cancelSearch();
+    threads = std::max(1, threads);
+    m_threads.resize(threads);
+    for (auto& thread : m_threads) {
+        if (!thread) thread = std::make_unique<SearchThread>();
+    }
+    m_threads[0]->isMain = true;
+}
+
+void AIPlayer::prepareSearch(Color color) {
+    // Une copie du board par thread et par recherche, ensuite tout se fait en place
+    // Les positions de la partie encore répétables précèdent la racine dans la pile
+    std::vector<std::uint64_t> window = m_logic.getRepetitionWindow();
+    int halfmoveClock = m_logic.getHalfmoveClock();
+    for (auto& thread : m_threads) {
+        thread->board = m_board;
+        thread->board.setSideToMove(color);
+        thread->keys.clear();
+        thread->keys.reserve(window.size() + 2 * MAX_PLY);
+        for (std::size_t i = 0; i < window.size(); ++i) {
+            thread->keys.push_back({window[i], halfmoveClock - static_cast<int>(window.size() - i)});
+        }
+        thread->keys.push_back({thread->board.getHash(), halfmoveClock});
+        thread->nodes = 0;
+        thread->qnodes = 0;
+        thread->cutoffs = 0;
+        thread->firstMoveCutoffs = 0;
+        thread->ttProbes = 0;
+        thread->ttHits = 0;
+        thread->tbHits = 0;
+        thread->previousPv.clear();
+        for (auto& killers : thread->killers) killers.fill(PackedMove());
+        for (auto& side : thread->history) {
+            for (auto& from : side) from.fill(0);
+        }
+    }
+    m_rootColor = color;
+    m_stats.reset();
+    
+    m_searchStart = std::chrono::steady_clock::now();
+    m_clockStartMs = 0;
+    m_timeBudgetMs = computeTimeBudget();
+    m_stopSearch = false;
+}
+
+Move AIPlayer::runSearch() {
+    SearchThread& main = *m_threads[0];
+    
+    // Coups de la racine générés sur la copie : ChessLogic et le board réel
+    // restent à la boucle de jeu pendant que la recherche tourne
+    PackedMoveList moves;
+    generateMoves(main.board, m_rootColor, moves);
+    
+    // Toujours promouvoir en dame
+    moves.resize(std::remove_if(moves.begin(), moves.end(), [](PackedMove m) {
+        return m.isPromotion() && m.promotion() != PieceType::Queen;
+    }) - moves.begin());
+    
+    if (moves.empty()) {
+        collectStats();
+        return Move{};
+    }
+    
+    // Position connue du livre : coup immédiat, sans recherche
+    PackedMove bookMove = probeBook(main.board, moves);
+    if (!bookMove.isNull()) {
+        main.previousPv.assign(1, bookMove);
+        m_stats.bookMove = true;
+        collectStats();
+        return bookMove.toMove();
+    }
+    
+    // Finale des tables : le coup DTZ garde le résultat, inutile de chercher
+    int tbScore = 0;
+    PackedMove tbMove = probeTablebaseRoot(main.board, main.keys.back().halfmoveClock, moves, tbScore);
+    if (!tbMove.isNull()) {
+        main.previousPv.assign(1, tbMove);
+        m_stats.tablebaseMove = true;
+        m_stats.score = tbScore;
+        collectStats();
+        return tbMove.toMove();
+    }
+    
+    // Lazy SMP : les threads auxiliaires cherchent la même position et remplissent
+    // la table partagée, le thread principal en profite pour couper plus tôt
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < m_threads.size(); ++i) {
+        helpers.emplace_back(&AIPlayer::helperSearch, this, std::ref(*m_threads[i]), moves, static_cast<int>(i));
+    }
+    
+    PackedMove bestMove = moves[0];
+    PackedMoveList bestMoves;
+    
+    // Approfondissement itératif : on garde le résultat de la dernière itération complète
+    for (int depth = 1; depth <= getMaxDepth(); ++depth) {
+        main.followPv = !main.previousPv.empty();
+        int score = searchRoot(main, moves, depth, bestMoves);
+        
+        if (m_stopSearch || bestMoves.empty()) {
+            break;
+        }
+        m_stats.depth = depth;
+        m_stats.score = score;
+        m_stats.iterations.push_back({depth, score, searchedNodes(), elapsedMs()});
+        
+        // Choisir aléatoirement parmi les meilleurs coups
+        if (m_deterministic) {
+            bestMove = bestMoves[0];
+        } else {
+            std::uniform_int_distribution<size_t> dist(0, bestMoves.size() - 1);
+            bestMove = bestMoves[dist(m_rng)];
+        }
+        
+        // La variation principale guide l'ordre des coups de l'itération suivante
+        if (main.pvLength[0] > 0 && main.pvTable[0][0] == bestMove) {
+            main.previousPv.assign(main.pvTable[0].begin(), main.pvTable[0].begin() + main.pvLength[0]);
+        } else {
+            main.previousPv.assign(1, bestMove);
+        }
+        auto it = std::find(moves.begin(), moves.end(), bestMove);
+        std::rotate(moves.begin(), it, it + 1);
+        
+        if (m_onIteration) {
+            std::vector<Move> pv;
+            for (PackedMove move : main.previousPv) pv.push_back(move.toMove());
+            m_onIteration(m_stats.iterations.back(), pv);
+        }
+        
+        // Mat à portée de l'itération terminée : chercher plus profond ne le changera pas
+        if (std::abs(score) > MATE_SCORE - MAX_PLY && MATE_SCORE - std::abs(score) <= depth) {
+            break;
+        }
+        
+        // Il est peu probable que l'itération suivante termine dans le temps restant
+        if (!m_pondering && m_timeBudgetMs > 0 && clockMs() > m_timeBudgetMs / 2) {
+            break;
+        }
+    }
+    
+    // Le résultat du thread principal fait foi : arrêter les auxiliaires
+    m_stopSearch = true;
+    for (std::thread& helper : helpers) {
+        helper.join();
     }
     
-    // Choisir aléatoirement parmi les meilleurs coups
-    std::uniform_int_distribution<size_t> dist(0, bestMoves.size() - 1);
-    return bestMoves[dist(m_rng)];
+    collectStats();
+    return bestMove.toMove();
+}
+
+PackedMove AIPlayer::probeBook(const Board& board, const PackedMoveList& moves) {
+    std::vector<PackedMove> candidates;
+    std::vector<int> weights;
+    for (const BookEntry& entry : m_book.probe(board)) {
+        // Le livre peut venir d'ailleurs : ne garder que les coups légaux ici
+        auto it = std::find_if(moves.begin(), moves.end(), [&entry](PackedMove m) {
+            return m.from() == entry.move.from() && m.to() == entry.move.to() &&
+                   m.promotion() == entry.move.promotion();
+        });
+        if (it != moves.end() && entry.weight > 0) {
+            candidates.push_back(*it);
+            weights.push_back(entry.weight);
+        }
+    }
+    if (candidates.empty()) {
+        return PackedMove();
+    }
+    
+    if (m_deterministic) {
+        return candidates[std::max_element(weights.begin(), weights.end()) - weights.begin()];
+    }
+    std::discrete_distribution<std::size_t> dist(weights.begin(), weights.end());
+    return candidates[dist(m_rng)];
+}
+
+PackedMove AIPlayer::probeTablebaseRoot(const Board& board, int halfmoveClock, const PackedMoveList& moves,
+                                        int& score) const {
+    PackedMove tbMove;
+    Tablebase::Wdl wdl;
+    if (m_tbPieceLimit <= 0 || !Tablebase::canProbe(board, m_tbPieceLimit) ||
+        !Tablebase::probeRoot(board, halfmoveClock, tbMove, wdl)) {
+        return PackedMove();
+    }
+    
+    // Une sous-promotion n'est pas parmi les coups de la racine : on cherche alors normalement
+    auto it = std::find_if(moves.begin(), moves.end(), [&tbMove](PackedMove m) {
+        return m.from() == tbMove.from() && m.to() == tbMove.to() && m.promotion() == tbMove.promotion();
+    });
+    if (it == moves.end()) {
+        return PackedMove();
+    }
+    
+    score = wdl == Tablebase::Wdl::Win ? TB_WIN_SCORE : wdl == Tablebase::Wdl::Loss ? -TB_WIN_SCORE : 0;
+    return *it;
+}
+
+std::uint64_t AIPlayer::searchedNodes() const {
+    std::uint64_t nodes = 0;
+    for (const auto& thread : m_threads) {
+        nodes += thread->nodes.load(std::memory_order_relaxed);
+    }
+    return nodes;
+}
+
+void AIPlayer::collectStats() {
+    for (const auto& thread : m_threads) {
+        m_stats.nodes += thread->nodes.load(std::memory_order_relaxed);
+        m_stats.qnodes += thread->qnodes;
+        m_stats.cutoffs += thread->cutoffs;
+        m_stats.firstMoveCutoffs += thread->firstMoveCutoffs;
+        m_stats.ttProbes += thread->ttProbes;
+        m_stats.ttHits += thread->ttHits;
+        m_stats.tbHits += thread->tbHits;
+    }
+    m_stats.elapsedMs = elapsedMs();
+    m_stats.threads = static_cast<int>(m_threads.size());
+    
+    // Variation principale de la dernière itération terminée, prolongée par les
+    // coups de la table quand une coupure de la table l'a tronquée
+    m_stats.pv.clear();
+    Board board = m_threads[0]->board;
+    std::vector<PackedMove> line = m_threads[0]->previousPv;
+    for (std::size_t i = 0; i < static_cast<std::size_t>(MAX_PLY); ++i) {
+        PackedMoveList moves;
+        generateMoves(board, board.getSideToMove(), moves);
+        
+        PackedMove move;
+        TTEntry entry;
+        if (i < line.size()) {
+            move = line[i];
+        } else if (i >= static_cast<std::size_t>(m_stats.depth) || !m_tt.probe(board.getHash(), entry)) {
+            break;
+        } else {
+            move = entry.move;
+        }
+        if (std::find(moves.begin(), moves.end(), move) == moves.end()) break;
+        
+        m_stats.pv.push_back(move.toMove());
+        board.applyMove(move);
+    }
+}
+
+void AIPlayer::helperSearch(SearchThread& thread, PackedMoveList moves, int index) {
+    PackedMoveList bestMoves;
+    
+    for (int depth = 1 + index % 2; depth <= getMaxDepth(); ++depth) {
+        thread.followPv = !thread.previousPv.empty();
+        searchRoot(thread, moves, depth, bestMoves);
+        
+        if (m_stopSearch || bestMoves.empty()) {
+            break;
+        }
+        
+        thread.previousPv.assign(thread.pvTable[0].begin(), thread.pvTable[0].begin() + thread.pvLength[0]);
+        auto it = std::find(moves.begin(), moves.end(), bestMoves[0]);
+        std::rotate(moves.begin(), it, it + 1);
+    }
 }
 
 } // namespace Chess
@@ -1,8 +1,16 @@
 #include "Board.hpp"
+#include "Zobrist.hpp"
+#include "Evaluation.hpp"
+#include <cstdlib>
+#include <sstream>
 
 namespace Chess {
 
-Board::Board() {
+Board::Board()
+    : m_sideToMove(Color::White)
+    , m_hash(0)
+    , m_enPassantKey(0)
+    , m_evaluation(0) {
     clear();
 }
 
@@ -11,8 +19,8 @@ void Board::initialize() {
     
     // Set up pawns
     for (int col = 0; col < 8; ++col) {
-        m_board[1][col] = Piece(PieceType::Pawn, Color::Black);
-        m_board[6][col] = Piece(PieceType::Pawn, Color::White);
+        setPiece({1, col}, Piece(PieceType::Pawn, Color::Black));
+        setPiece({6, col}, Piece(PieceType::Pawn, Color::White));
     }
     
     // Set up back ranks
@@ -22,96 +30,546 @@ void Board::initialize() {
     };
     
     for (int col = 0; col < 8; ++col) {
-        m_board[0][col] = Piece(backRank[col], Color::Black);
-        m_board[7][col] = Piece(backRank[col], Color::White);
+        setPiece({0, col}, Piece(backRank[col], Color::Black));
+        setPiece({7, col}, Piece(backRank[col], Color::White));
     }
     
     // Reset castling rights
-    m_castlingRights = {true, true, true, true};
+    setCastlingRights(ALL_CASTLING);
     
     // Clear en passant
     clearEnPassantTarget();
 }
 
-void Board::clear() {
-    for (auto& row : m_board) {
-        for (auto& piece : row) {
-            piece = Piece();
+bool Board::loadFEN(const std::string& fen) {
+    std::istringstream fields(fen);
+    std::string placement, side, castling, enPassant;
+    if (!(fields >> placement >> side)) {
+        return false;
+    }
+    fields >> castling >> enPassant;
+    
+    clear();
+    
+    // Piece placement, rank 8 first: this matches row 0 of the array
+    int row = 0;
+    int col = 0;
+    for (char c : placement) {
+        if (c == '/') {
+            if (col != 8) return false;
+            ++row;
+            col = 0;
+        } else if (c >= '1' && c <= '8') {
+            col += c - '0';
+        } else {
+            PieceType type = PieceType::None;
+            switch (c | 0x20) {
+                case 'p': type = PieceType::Pawn; break;
+                case 'n': type = PieceType::Knight; break;
+                case 'b': type = PieceType::Bishop; break;
+                case 'r': type = PieceType::Rook; break;
+                case 'q': type = PieceType::Queen; break;
+                case 'k': type = PieceType::King; break;
+                default: return false;
+            }
+            if (row > 7 || col > 7) return false;
+            Piece piece(type, (c & 0x20) ? Color::Black : Color::White);
+            // Only castling pieces care about the flag, they are fixed up below
+            piece.setMoved(type == PieceType::King || type == PieceType::Rook);
+            setPiece({row, col}, piece);
+            ++col;
         }
     }
-    m_castlingRights = {false, false, false, false};
-    clearEnPassantTarget();
+    if (row != 7 || col != 8) return false;
+    
+    if (side != "w" && side != "b") return false;
+    setSideToMove(side == "w" ? Color::White : Color::Black);
+    
+    // Castling rights, only kept when the king and rook still stand on their squares
+    std::uint8_t rights = 0;
+    const char flags[4] = {'K', 'Q', 'k', 'q'};
+    for (int i = 0; i < 4; ++i) {
+        if (castling.find(flags[i]) == std::string::npos) continue;
+        Color color = i < 2 ? Color::White : Color::Black;
+        int homeRow = color == Color::White ? 7 : 0;
+        int rookCol = (i % 2 == 0) ? 7 : 0;
+        Piece& king = m_squares[homeRow * 8 + 4];
+        Piece& rook = m_squares[homeRow * 8 + rookCol];
+        if (king.getType() == PieceType::King && king.getColor() == color &&
+            rook.getType() == PieceType::Rook && rook.getColor() == color) {
+            rights |= 1 << i;
+            king.setMoved(false);
+            rook.setMoved(false);
+        }
+    }
+    setCastlingRights(rights);
+    
+    if (enPassant.size() == 2 && enPassant[0] >= 'a' && enPassant[0] <= 'h' &&
+        (enPassant[1] == '3' || enPassant[1] == '6')) {
+        setEnPassantTarget({'8' - enPassant[1], enPassant[0] - 'a'});
+    }
+    
+    return true;
+}
+
+std::string Board::toFEN(int halfmoveClock, int fullmoveNumber) const {
+    std::string fen;
+    fen.reserve(90);
+    for (int row = 0; row < 8; ++row) {
+        int empty = 0;
+        for (int col = 0; col < 8; ++col) {
+            const Piece& piece = m_squares[row * 8 + col];
+            if (piece.isEmpty()) {
+                ++empty;
+                continue;
+            }
+            if (empty > 0) {
+                fen += static_cast<char>('0' + empty);
+                empty = 0;
+            }
+            char c = ' ';
+            switch (piece.getType()) {
+                case PieceType::Pawn: c = 'p'; break;
+                case PieceType::Knight: c = 'n'; break;
+                case PieceType::Bishop: c = 'b'; break;
+                case PieceType::Rook: c = 'r'; break;
+                case PieceType::Queen: c = 'q'; break;
+                case PieceType::King: c = 'k'; break;
+                default: break;
+            }
+            fen += piece.getColor() == Color::White ? static_cast<char>(c - 0x20) : c;
+        }
+        if (empty > 0) {
+            fen += static_cast<char>('0' + empty);
+        }
+        if (row < 7) {
+            fen += '/';
+        }
+    }
+    
+    fen += m_sideToMove == Color::White ? " w " : " b ";
+    
+    const char flags[4] = {'K', 'Q', 'k', 'q'};
+    bool anyRight = false;
+    for (int i = 0; i < 4; ++i) {
+        if (m_castlingRights & (1 << i)) {
+            fen += flags[i];
+            anyRight = true;
+        }
+    }
+    if (!anyRight) {
+        fen += '-';
+    }
+    
+    if (m_enPassantTarget.isValid()) {
+        fen += ' ';
+        fen += static_cast<char>('a' + m_enPassantTarget.col);
+        fen += static_cast<char>('8' - m_enPassantTarget.row);
+    } else {
+        fen += " -";
+    }
+    
+    fen += ' ' + std::to_string(halfmoveClock) + ' ' + std::to_string(fullmoveNumber);
+    return fen;
+}
+
+void Board::clear() {
+    m_squares.fill(Piece());
+    for (auto& side : m_pieceBB) {
+        side.fill(0);
+    }
+    m_colorBB.fill(0);
+    m_castlingRights = 0;
+    m_enPassantTarget = {-1, -1};
+    m_enPassantKey = 0;
+    m_sideToMove = Color::White;
+    m_hash = 0;
+    m_evaluation = 0;
 }
 
 Piece& Board::getPiece(const Position& pos) {
-    return m_board[pos.row][pos.col];
+    return m_squares[squareIndex(pos)];
 }
 
 const Piece& Board::getPiece(const Position& pos) const {
-    return m_board[pos.row][pos.col];
+    return m_squares[squareIndex(pos)];
 }
 
 Piece& Board::getPiece(int row, int col) {
-    return m_board[row][col];
+    return m_squares[row * 8 + col];
 }
 
 const Piece& Board::getPiece(int row, int col) const {
-    return m_board[row][col];
+    return m_squares[row * 8 + col];
+}
+
+void Board::addToBitboards(int sq, const Piece& piece) {
+    if (piece.isEmpty()) return;
+    Bitboard bit = squareBit(sq);
+    m_pieceBB[colorIndex(piece.getColor())][bitboardIndex(piece.getType())] |= bit;
+    m_colorBB[colorIndex(piece.getColor())] |= bit;
+    m_hash ^= Zobrist::KEYS.pieces[colorIndex(piece.getColor())][typeIndex(piece.getType())][sq];
+    int value = Eval::PIECE_SQUARE[colorIndex(piece.getColor())][typeIndex(piece.getType())][sq];
+    m_evaluation += piece.getColor() == Color::White ? value : -value;
+}
+
+void Board::removeFromBitboards(int sq, const Piece& piece) {
+    if (piece.isEmpty()) return;
+    Bitboard bit = squareBit(sq);
+    m_pieceBB[colorIndex(piece.getColor())][bitboardIndex(piece.getType())] &= ~bit;
+    m_colorBB[colorIndex(piece.getColor())] &= ~bit;
+    m_hash ^= Zobrist::KEYS.pieces[colorIndex(piece.getColor())][typeIndex(piece.getType())][sq];
+    int value = Eval::PIECE_SQUARE[colorIndex(piece.getColor())][typeIndex(piece.getType())][sq];
+    m_evaluation -= piece.getColor() == Color::White ? value : -value;
 }
 
 void Board::setPiece(const Position& pos, const Piece& piece) {
-    m_board[pos.row][pos.col] = piece;
+    int sq = squareIndex(pos);
+    removeFromBitboards(sq, m_squares[sq]);
+    m_squares[sq] = piece;
+    addToBitboards(sq, piece);
 }
 
 void Board::movePiece(const Position& from, const Position& to) {
-    m_board[to.row][to.col] = m_board[from.row][from.col];
-    m_board[to.row][to.col].setMoved(true);
-    m_board[from.row][from.col] = Piece();
+    Piece piece = m_squares[squareIndex(from)];
+    removePiece(from);
+    piece.setMoved(true);
+    setPiece(to, piece);
 }
 
 void Board::removePiece(const Position& pos) {
-    m_board[pos.row][pos.col] = Piece();
+    int sq = squareIndex(pos);
+    removeFromBitboards(sq, m_squares[sq]);
+    m_squares[sq] = Piece();
 }
 
-Position Board::findKing(Color color) const {
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            const Piece& piece = m_board[row][col];
-            if (piece.getType() == PieceType::King && piece.getColor() == color) {
-                return {row, col};
-            }
+MoveRecord Board::applyMove(PackedMove move) {
+    Position from = squarePosition(move.from());
+    Position to = squarePosition(move.to());
+    
+    MoveRecord record;
+    record.move = move;
+    record.enPassantTarget = m_enPassantTarget;
+    record.castlingRights = m_castlingRights;
+    record.wasEnPassantCapture = move.isEnPassant();
+    record.movedPiece = getPiece(from);
+    Color pieceColor = record.movedPiece.getColor();
+    
+    // En passant removes the pawn beside the destination square
+    if (move.isEnPassant()) {
+        record.enPassantCapturePos = {from.row, to.col};
+        record.capturedPiece = getPiece(record.enPassantCapturePos);
+        removePiece(record.enPassantCapturePos);
+    } else {
+        record.capturedPiece = getPiece(to);
+        record.enPassantCapturePos = {-1, -1};
+    }
+    
+    if (move.isCastling()) {
+        movePiece(from, to);
+        
+        int rookFromCol = (to.col > from.col) ? 7 : 0;
+        int rookToCol = (to.col > from.col) ? 5 : 3;
+        movePiece({from.row, rookFromCol}, {from.row, rookToCol});
+    } else {
+        movePiece(from, to);
+        
+        if (move.promotion() != PieceType::None) {
+            Piece promotedPiece(move.promotion(), pieceColor);
+            promotedPiece.setMoved(true);
+            setPiece(to, promotedPiece);
         }
     }
-    return {-1, -1};
+    
+    // New en passant target after a double pawn push
+    clearEnPassantTarget();
+    if (record.movedPiece.getType() == PieceType::Pawn &&
+        std::abs(to.row - from.row) == 2) {
+        setEnPassantTarget({(from.row + to.row) / 2, from.col});
+    }
+    
+    // Castling rights are lost when the king or a rook leaves its square,
+    // or when a rook is captured on its original corner
+    if (record.movedPiece.getType() == PieceType::King) {
+        disableCastling(pieceColor, true);
+        disableCastling(pieceColor, false);
+    }
+    if (record.movedPiece.getType() == PieceType::Rook) {
+        int homeRow = (pieceColor == Color::White) ? 7 : 0;
+        if (from.row == homeRow && from.col == 0) {
+            disableCastling(pieceColor, false);
+        } else if (from.row == homeRow && from.col == 7) {
+            disableCastling(pieceColor, true);
+        }
+    }
+    if (record.capturedPiece.getType() == PieceType::Rook) {
+        Color capturedColor = record.capturedPiece.getColor();
+        int homeRow = (capturedColor == Color::White) ? 7 : 0;
+        if (to.row == homeRow && to.col == 0) {
+            disableCastling(capturedColor, false);
+        } else if (to.row == homeRow && to.col == 7) {
+            disableCastling(capturedColor, true);
+        }
+    }
+    
+    setSideToMove(opponentOf(m_sideToMove));
+    
+    return record;
+}
+
+void Board::revertMove(const MoveRecord& record) {
+    PackedMove move = record.move;
+    Position from = squarePosition(move.from());
+    Position to = squarePosition(move.to());
+    
+    if (move.isCastling()) {
+        // Put the king and the rook back with their original moved flags
+        int rookFromCol = (to.col > from.col) ? 7 : 0;
+        int rookToCol = (to.col > from.col) ? 5 : 3;
+        Piece rook = getPiece(from.row, rookToCol);
+        rook.setMoved(false);
+        removePiece({from.row, rookToCol});
+        setPiece({from.row, rookFromCol}, rook);
+        removePiece(to);
+        setPiece(from, record.movedPiece);
+    } else if (record.wasEnPassantCapture) {
+        // The captured pawn goes back beside the destination, not on it
+        setPiece(from, record.movedPiece);
+        removePiece(to);
+        setPiece(record.enPassantCapturePos, record.capturedPiece);
+    } else {
+        setPiece(from, record.movedPiece);
+        setPiece(to, record.capturedPiece);
+    }
+    
+    if (record.enPassantTarget.isValid()) {
+        setEnPassantTarget(record.enPassantTarget);
+    } else {
+        clearEnPassantTarget();
+    }
+    setCastlingRights(record.castlingRights);
+    setSideToMove(opponentOf(m_sideToMove));
+}
+
+MoveRecord Board::applyNullMove() {
+    MoveRecord record{};
+    record.enPassantTarget = m_enPassantTarget;
+    record.castlingRights = m_castlingRights;
+    record.enPassantCapturePos = {-1, -1};
+    clearEnPassantTarget();
+    setSideToMove(opponentOf(m_sideToMove));
+    return record;
+}
+
+void Board::revertNullMove(const MoveRecord& record) {
+    if (record.enPassantTarget.isValid()) {
+        setEnPassantTarget(record.enPassantTarget);
+    }
+    setSideToMove(opponentOf(m_sideToMove));
+}
+
+Position Board::findKing(Color color) const {
+    Bitboard kings = getPieces(color, PieceType::King);
+    if (!kings) {
+        return {-1, -1};
+    }
+    return squarePosition(lsb(kings));
 }
 
 std::vector<Position> Board::findPieces(Color color) const {
     std::vector<Position> positions;
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            if (m_board[row][col].getColor() == color) {
-                positions.push_back({row, col});
+    Bitboard pieces = getPieces(color);
+    positions.reserve(popCount(pieces));
+    while (pieces) {
+        positions.push_back(squarePosition(popLsb(pieces)));
+    }
+    return positions;
+}
+
+template <Color ByColor>
+Bitboard Board::attackersTo(int sq, Bitboard occupied) const {
+    const auto& bb = m_pieceBB[Side<ByColor>::INDEX];
+    Bitboard diagonal = bb[bitboardIndex(PieceType::Bishop)] | bb[bitboardIndex(PieceType::Queen)];
+    Bitboard straight = bb[bitboardIndex(PieceType::Rook)] | bb[bitboardIndex(PieceType::Queen)];
+    
+    // A pawn of ByColor attacks sq if a pawn of the other colour on sq would attack it back
+    return (Attacks::PAWN[Side<Side<ByColor>::THEM>::INDEX][sq] & bb[bitboardIndex(PieceType::Pawn)])
+         | (Attacks::knight(sq) & bb[bitboardIndex(PieceType::Knight)])
+         | (Attacks::king(sq) & bb[bitboardIndex(PieceType::King)])
+         | (Attacks::bishop(sq, occupied) & diagonal)
+         | (Attacks::rook(sq, occupied) & straight);
+}
+
+Bitboard Board::attackersTo(int sq, Color byColor, Bitboard occupied) const {
+    return byColor == Color::White ? attackersTo<Color::White>(sq, occupied)
+                                   : attackersTo<Color::Black>(sq, occupied);
+}
+
+bool Board::isAttacked(const Position& pos, Color byColor) const {
+    return attackersTo(squareIndex(pos), byColor, getOccupied()) != 0;
+}
+
+template <Color Us>
+LegalityInfo Board::legalityInfo() const {
+    constexpr Color opponent = Side<Us>::THEM;
+    LegalityInfo info;
+    Bitboard kings = getPieces(Us, PieceType::King);
+    if (!kings) {
+        return info;
+    }
+    
+    Bitboard occupied = getOccupied();
+    info.kingSq = lsb(kings);
+    info.checkers = attackersTo<opponent>(info.kingSq, occupied);
+    
+    // Enemy sliders lined up with the king; a lone own piece in between is pinned
+    const auto& enemy = m_pieceBB[Side<opponent>::INDEX];
+    Bitboard snipers =
+        (Attacks::rook(info.kingSq, 0) & (enemy[bitboardIndex(PieceType::Rook)] | enemy[bitboardIndex(PieceType::Queen)])) |
+        (Attacks::bishop(info.kingSq, 0) & (enemy[bitboardIndex(PieceType::Bishop)] | enemy[bitboardIndex(PieceType::Queen)]));
+    while (snipers) {
+        Bitboard blockers = Attacks::between(info.kingSq, popLsb(snipers)) & occupied;
+        if (blockers && !(blockers & (blockers - 1)) && (blockers & m_colorBB[Side<Us>::INDEX])) {
+            info.pinned |= blockers;
+        }
+    }
+    return info;
+}
+
+LegalityInfo Board::legalityInfo(Color color) const {
+    return color == Color::White ? legalityInfo<Color::White>() : legalityInfo<Color::Black>();
+}
+
+template <Color Us>
+bool Board::isLegal(PackedMove move, const LegalityInfo& info) const {
+    if (info.kingSq < 0) return true;
+    
+    constexpr Color opponent = Side<Us>::THEM;
+    int from = move.from();
+    int to = move.to();
+    Bitboard occupied = getOccupied();
+    
+    // The king may not step onto an attacked square (its own square no longer blocks
+    // the slider that checks it)
+    if (from == info.kingSq) {
+        Bitboard after = occupied ^ squareBit(from);
+        return (attackersTo<opponent>(to, after) & ~squareBit(to)) == 0;
+    }
+    
+    // En passant removes two pieces from the same rank: replay it on the occupancy
+    if (move.isEnPassant()) {
+        int captured = to - Side<Us>::PUSH;
+        Bitboard after = (occupied ^ squareBit(from) ^ squareBit(captured)) | squareBit(to);
+        return (attackersTo<opponent>(info.kingSq, after) & after) == 0;
+    }
+    
+    if (info.checkers) {
+        // Double check: only the king can move
+        if (info.checkers & (info.checkers - 1)) return false;
+        // Single check: capture the checker or block the line
+        Bitboard evasions = info.checkers | Attacks::between(info.kingSq, lsb(info.checkers));
+        if (!(evasions & squareBit(to))) return false;
+    }
+    
+    // A pinned piece can only slide along the pin line
+    return !(info.pinned & squareBit(from)) || (Attacks::line(info.kingSq, from) & squareBit(to));
+}
+
+bool Board::isLegal(PackedMove move, const LegalityInfo& info) const {
+    return m_squares[move.from()].getColor() == Color::White ? isLegal<Color::White>(move, info)
+                                                             : isLegal<Color::Black>(move, info);
+}
+
+template Bitboard Board::attackersTo<Color::White>(int, Bitboard) const;
+template Bitboard Board::attackersTo<Color::Black>(int, Bitboard) const;
+template LegalityInfo Board::legalityInfo<Color::White>() const;
+template LegalityInfo Board::legalityInfo<Color::Black>() const;
+template bool Board::isLegal<Color::White>(PackedMove, const LegalityInfo&) const;
+template bool Board::isLegal<Color::Black>(PackedMove, const LegalityInfo&) const;
+
+void Board::setSideToMove(Color color) {
+    if (color != m_sideToMove) {
+        m_hash ^= Zobrist::KEYS.blackToMove;
+        m_sideToMove = color;
+    }
+}
+
+// Only hash the en passant file when an enemy pawn can actually take, so that
+// transpositions and repetitions are not split by a meaningless target
+std::uint64_t Board::enPassantKey(const Position& target) const {
+    if (!target.isValid()) return 0;
+    Color pusher = (target.row == 5) ? Color::White : Color::Black;
+    Bitboard takers = Attacks::pawn(pusher, squareIndex(target)) & getPieces(opponentOf(pusher), PieceType::Pawn);
+    return takers ? Zobrist::KEYS.enPassantFile[target.col] : 0;
+}
+
+void Board::setEnPassantTarget(const Position& pos) {
+    clearEnPassantTarget();
+    m_enPassantTarget = pos;
+    m_enPassantKey = enPassantKey(pos);
+    m_hash ^= m_enPassantKey;
+}
+
+void Board::clearEnPassantTarget() {
+    m_hash ^= m_enPassantKey;
+    m_enPassantKey = 0;
+    m_enPassantTarget = {-1, -1};
+}
+
+void Board::setCastlingRights(std::uint8_t rights) {
+    for (int i = 0; i < 4; ++i) {
+        if ((m_castlingRights ^ rights) & (1 << i)) {
+            m_hash ^= Zobrist::KEYS.castling[i];
+        }
+    }
+    m_castlingRights = rights;
+}
+
+std::uint64_t Board::computeHash() const {
+    std::uint64_t hash = 0;
+    for (int side = 0; side < 2; ++side) {
+        for (int type = typeIndex(PieceType::Pawn); type <= typeIndex(PieceType::King); ++type) {
+            Bitboard pieces = m_pieceBB[side][type - typeIndex(PieceType::Pawn)];
+            while (pieces) {
+                hash ^= Zobrist::KEYS.pieces[side][type][popLsb(pieces)];
             }
         }
     }
-    return positions;
+    for (int i = 0; i < 4; ++i) {
+        if (m_castlingRights & (1 << i)) hash ^= Zobrist::KEYS.castling[i];
+    }
+    hash ^= enPassantKey(m_enPassantTarget);
+    if (m_sideToMove == Color::Black) hash ^= Zobrist::KEYS.blackToMove;
+    return hash;
+}
+
+int Board::computeEvaluation() const {
+    int evaluation = 0;
+    for (int side = 0; side < 2; ++side) {
+        for (int type = typeIndex(PieceType::Pawn); type <= typeIndex(PieceType::King); ++type) {
+            Bitboard pieces = m_pieceBB[side][type - typeIndex(PieceType::Pawn)];
+            while (pieces) {
+                int value = Eval::PIECE_SQUARE[side][type][popLsb(pieces)];
+                evaluation += side == 0 ? value : -value;
+            }
+        }
+    }
+    return evaluation;
 }
 
 bool Board::canCastleKingside(Color color) const {
-    return color == Color::White ? m_castlingRights[0] : m_castlingRights[2];
+    return m_castlingRights & (color == Color::White ? 1 : 4);
 }
 
 bool Board::canCastleQueenside(Color color) const {
-    return color == Color::White ? m_castlingRights[1] : m_castlingRights[3];
+    return m_castlingRights & (color == Color::White ? 2 : 8);
 }
 
 void Board::disableCastling(Color color, bool kingside) {
-    if (color == Color::White) {
-        if (kingside) m_castlingRights[0] = false;
-        else m_castlingRights[1] = false;
-    } else {
-        if (kingside) m_castlingRights[2] = false;
-        else m_castlingRights[3] = false;
+    int index = (color == Color::White ? 0 : 2) + (kingside ? 0 : 1);
+    if (m_castlingRights & (1 << index)) {
+        m_castlingRights &= ~(1 << index);
+        m_hash ^= Zobrist::KEYS.castling[index];
     }
 }
 
@@ -1,36 +1,101 @@
 #include "ChessLogic.hpp"
 #include <algorithm>
+#include <cstdlib>
+#include <sstream>
 
 namespace Chess {
 
 ChessLogic::ChessLogic(Board& board)
     : m_board(board)
-    , m_currentTurn(Color::White) {
+    , m_currentTurn(board.getSideToMove())
+    , m_halfmoveClock(0)
+    , m_fullmoveNumber(1) {
+}
+
+void ChessLogic::reset(int halfmoveClock, int fullmoveNumber) {
+    m_currentTurn = m_board.getSideToMove();
+    m_moveHistory.clear();
+    m_halfmoveClock = halfmoveClock;
+    m_fullmoveNumber = fullmoveNumber;
+    m_cache.valid = false;
+}
+
+bool ChessLogic::loadFEN(const std::string& fen) {
+    if (!m_board.loadFEN(fen)) {
+        return false;
+    }
+    // Le board ignore les compteurs : demi-coups au cinquième champ, numéro du coup au sixième
+    std::istringstream fields(fen);
+    std::string field;
+    int halfmoveClock = 0;
+    int fullmoveNumber = 1;
+    for (int i = 0; fields >> field && i <= 5; ++i) {
+        if (i == 4) halfmoveClock = std::max(0, std::atoi(field.c_str()));
+        if (i == 5) fullmoveNumber = std::max(1, std::atoi(field.c_str()));
+    }
+    reset(halfmoveClock, fullmoveNumber);
+    return true;
+}
+
+std::vector<Move> ChessLogic::getMoveHistory() const {
+    std::vector<Move> moves;
+    moves.reserve(m_moveHistory.size());
+    for (const HistoryEntry& entry : m_moveHistory) {
+        moves.push_back(entry.record.move.toMove());
+    }
+    return moves;
 }
 
 std::vector<Move> ChessLogic::getLegalMoves(const Position& pos) const {
-    const Piece& piece = m_board.getPiece(pos);
-    if (piece.isEmpty() || piece.getColor() != m_currentTurn) {
-        return {};
+    // Les coups de la pièce sont extraits de la liste de la position courante
+    std::vector<Move> moves;
+    for (const Move& move : positionCache().moves) {
+        if (move.from == pos) {
+            moves.push_back(move);
+        }
     }
-    
-    std::vector<Move> pseudoMoves = getPseudoLegalMoves(pos);
-    std::vector<Move> legalMoves;
-    
-    for (const Move& move : pseudoMoves) {
-        if (!wouldBeInCheck(move)) {
-            legalMoves.push_back(move);
+    return moves;
+}
+
+const ChessLogic::PositionCache& ChessLogic::positionCache() const {
+    // Calculé au premier besoin, puis réutilisé jusqu'au prochain makeMove/undoMove
+    if (!m_cache.valid) {
+        m_cache.moves.clear();
+        generateAllLegalMoves(m_currentTurn, m_cache.moves);
+        bool inCheck = isInCheck(m_currentTurn);
+        if (m_cache.moves.empty()) {
+            m_cache.state = inCheck ? GameState::Checkmate : GameState::Stalemate;
+        } else if (m_halfmoveClock >= 100 || countRepetitions() >= 2) {
+            // Le mat au centième demi-coup l'emporte sur la règle des 50 coups
+            m_cache.state = GameState::Draw;
+        } else {
+            m_cache.state = inCheck ? GameState::Check : GameState::Playing;
         }
+        m_cache.valid = true;
     }
-    
-    return legalMoves;
+    return m_cache;
+}
+
+void ChessLogic::generateLegalMoves(const Position& pos, const LegalityInfo& info, MoveList& moves) const {
+    // Les coups pseudo-légaux sont ajoutés à la suite puis filtrés sur place,
+    // à partir des clouages et des échecs calculés une fois pour la position
+    std::size_t first = moves.size();
+    getPseudoLegalMoves(pos, moves);
+    
+    std::size_t kept = first;
+    for (std::size_t i = first; i < moves.size(); ++i) {
+        if (m_board.isLegal(PackedMove::fromMove(moves[i]), info)) {
+            moves[kept++] = moves[i];
+        }
+    }
+    moves.resize(kept);
 }
 
 bool ChessLogic::isLegalMove(const Move& move) const {
-    std::vector<Move> legalMoves = getLegalMoves(move.from);
+    const MoveList& legalMoves = positionCache().moves;
     return std::any_of(legalMoves.begin(), legalMoves.end(), 
         [&move](const Move& m) {
-            return m.to == move.to && m.promotion == move.promotion;
+            return m.from == move.from && m.to == move.to && m.promotion == move.promotion;
         });
 }
 
@@ -39,78 +104,22 @@ bool ChessLogic::makeMove(const Move& move) {
         return false;
     }
     
-    // Créer un enregistrement du coup pour pouvoir l'annuler
-    MoveRecord record;
-    record.move = move;
-    record.enPassantTarget = m_board.getEnPassantTarget();
-    record.castlingRights = m_board.getCastlingRights();
-    record.wasEnPassantCapture = move.isEnPassant;
-    
-    // Sauvegarder la pièce qui bouge
-    record.movedPiece = m_board.getPiece(move.from);
-    Color pieceColor = record.movedPiece.getColor();
-    
-    // Gérer la capture en passant
-    if (move.isEnPassant) {
-        record.enPassantCapturePos = {move.from.row, move.to.col};
-        record.capturedPiece = m_board.getPiece(record.enPassantCapturePos);
-        m_board.removePiece(record.enPassantCapturePos);
-    } else {
-        record.capturedPiece = m_board.getPiece(move.to);
-        record.enPassantCapturePos = {-1, -1};
-    }
-    
-    // Stocker l'enregistrement
-    m_moveHistory.push_back(record);
-    
-    // Gérer le roque
-    if (move.isCastling) {
-        m_board.movePiece(move.from, move.to);
-        
-        // Déplacer la tour
-        int rookFromCol = (move.to.col > move.from.col) ? 7 : 0;
-        int rookToCol = (move.to.col > move.from.col) ? 5 : 3;
-        m_board.movePiece({move.from.row, rookFromCol}, {move.from.row, rookToCol});
-        
-        // Désactiver les droits de roque
-        m_board.disableCastling(pieceColor, true);
-        m_board.disableCastling(pieceColor, false);
-    } else {
-        // Coup normal
-        m_board.movePiece(move.from, move.to);
-        
-        // Gérer la promotion
-        if (move.promotion != PieceType::None) {
-            Piece promotedPiece(move.promotion, pieceColor);
-            promotedPiece.setMoved(true);
-            m_board.setPiece(move.to, promotedPiece);
-        }
-    }
-    
-    // Mettre à jour la cible en passant
-    m_board.clearEnPassantTarget();
-    if (record.movedPiece.getType() == PieceType::Pawn) {
-        int rowDiff = move.to.row - move.from.row;
-        if (std::abs(rowDiff) == 2) {
-            m_board.setEnPassantTarget({(move.from.row + move.to.row) / 2, move.from.col});
-        }
-    }
-    
-    // Mettre à jour les droits de roque si la tour ou le roi bouge
-    if (record.movedPiece.getType() == PieceType::King) {
-        m_board.disableCastling(pieceColor, true);
-        m_board.disableCastling(pieceColor, false);
-    }
-    if (record.movedPiece.getType() == PieceType::Rook) {
-        if (move.from.col == 0) {
-            m_board.disableCastling(pieceColor, false);
-        } else if (move.from.col == 7) {
-            m_board.disableCastling(pieceColor, true);
-        }
+    // Jouer le coup et stocker l'enregistrement pour pouvoir l'annuler, avec la clé
+    // et le compteur des 50 coups de la position quittée
+    std::uint64_t hash = m_board.getHash();
+    MoveRecord record = m_board.applyMove(move);
+    m_moveHistory.push_back({record, hash, m_halfmoveClock});
+    
+    // Prise ou coup de pion : aucune position antérieure ne peut plus se répéter
+    bool irreversible = record.movedPiece.getType() == PieceType::Pawn || !record.capturedPiece.isEmpty();
+    m_halfmoveClock = irreversible ? 0 : m_halfmoveClock + 1;
+    if (m_currentTurn == Color::Black) {
+        ++m_fullmoveNumber;
     }
     
     // Changer de tour
     m_currentTurn = (m_currentTurn == Color::White) ? Color::Black : Color::White;
+    m_cache.valid = false;
     
     return true;
 }
@@ -120,46 +129,15 @@ bool ChessLogic::undoMove() {
         return false;
     }
     
-    const MoveRecord& record = m_moveHistory.back();
-    const Move& move = record.move;
-    
-    // Annuler le roque
-    if (move.isCastling) {
-        // Remettre le roi à sa position d'origine
-        m_board.movePiece(move.to, move.from);
-        
-        // Remettre la tour à sa position d'origine
-        int rookFromCol = (move.to.col > move.from.col) ? 7 : 0;
-        int rookToCol = (move.to.col > move.from.col) ? 5 : 3;
-        m_board.movePiece({move.from.row, rookToCol}, {move.from.row, rookFromCol});
-    } else if (record.wasEnPassantCapture) {
-        // Cas spécial: capture en passant
-        // Remettre le pion qui a bougé à sa position d'origine
-        m_board.setPiece(move.from, record.movedPiece);
-        // Vider la case d'arrivée
-        m_board.setPiece(move.to, Piece());
-        // Remettre le pion capturé à sa position (pas sur move.to!)
-        m_board.setPiece(record.enPassantCapturePos, record.capturedPiece);
-    } else {
-        // Coup normal ou capture normale
-        // Remettre la pièce à sa position d'origine
-        m_board.setPiece(move.from, record.movedPiece);
-        // Restaurer la pièce capturée (ou case vide) sur la case d'arrivée
-        m_board.setPiece(move.to, record.capturedPiece);
-    }
-    
-    // Restaurer la cible en passant
-    if (record.enPassantTarget.isValid()) {
-        m_board.setEnPassantTarget(record.enPassantTarget);
-    } else {
-        m_board.clearEnPassantTarget();
-    }
-    
-    // Restaurer les droits de roque
-    m_board.setCastlingRights(record.castlingRights);
+    m_board.revertMove(m_moveHistory.back().record);
+    m_halfmoveClock = m_moveHistory.back().halfmoveClock;
     
     // Changer de tour (revenir au joueur précédent)
     m_currentTurn = (m_currentTurn == Color::White) ? Color::Black : Color::White;
+    if (m_currentTurn == Color::Black) {
+        --m_fullmoveNumber;
+    }
+    m_cache.valid = false;
     
     // Supprimer l'enregistrement
     m_moveHistory.pop_back();
@@ -178,190 +156,130 @@ bool ChessLogic::isInCheck(Color color) const {
 }
 
 bool ChessLogic::isCheckmate(Color color) const {
+    if (color == m_currentTurn) {
+        return positionCache().state == GameState::Checkmate;
+    }
     if (!isInCheck(color)) {
         return false;
     }
     
-    // Check if any piece has legal moves
-    std::vector<Position> pieces = m_board.findPieces(color);
-    for (const Position& pos : pieces) {
-        // Temporarily switch turn to check moves
-        Color savedTurn = m_currentTurn;
-        const_cast<Color&>(m_currentTurn) = color;
-        
-        std::vector<Move> moves = getLegalMoves(pos);
-        
-        const_cast<Color&>(m_currentTurn) = savedTurn;
-        
-        if (!moves.empty()) {
-            return false;
-        }
-    }
-    
-    return true;
+    return !hasLegalMove(color);
 }
 
 bool ChessLogic::isStalemate(Color color) const {
+    if (color == m_currentTurn) {
+        return positionCache().state == GameState::Stalemate;
+    }
     if (isInCheck(color)) {
         return false;
     }
     
-    // Check if any piece has legal moves
-    std::vector<Position> pieces = m_board.findPieces(color);
-    for (const Position& pos : pieces) {
-        Color savedTurn = m_currentTurn;
-        const_cast<Color&>(m_currentTurn) = color;
-        
-        std::vector<Move> moves = getLegalMoves(pos);
-        
-        const_cast<Color&>(m_currentTurn) = savedTurn;
-        
+    return !hasLegalMove(color);
+}
+
+bool ChessLogic::hasLegalMove(Color color) const {
+    MoveList moves;
+    LegalityInfo info = m_board.legalityInfo(color);
+    Bitboard pieces = m_board.getPieces(color);
+    while (pieces) {
+        generateLegalMoves(squarePosition(popLsb(pieces)), info, moves);
         if (!moves.empty()) {
-            return false;
+            return true;
         }
     }
-    
-    return true;
+    return false;
 }
 
 std::vector<Move> ChessLogic::getAllLegalMoves(Color color) const {
-    std::vector<Move> allMoves;
-    std::vector<Position> pieces = m_board.findPieces(color);
-    
-    Color savedTurn = m_currentTurn;
-    const_cast<Color&>(m_currentTurn) = color;
-    
-    for (const Position& pos : pieces) {
-        std::vector<Move> moves = getLegalMoves(pos);
-        allMoves.insert(allMoves.end(), moves.begin(), moves.end());
+    MoveList moves;
+    getAllLegalMoves(color, moves);
+    return std::vector<Move>(moves.begin(), moves.end());
+}
+
+void ChessLogic::getAllLegalMoves(Color color, MoveList& moves) const {
+    if (color != m_currentTurn) {
+        generateAllLegalMoves(color, moves);
+        return;
+    }
+    for (const Move& move : positionCache().moves) {
+        moves.push_back(move);
     }
-    
-    const_cast<Color&>(m_currentTurn) = savedTurn;
-    return allMoves;
 }
 
-GameState ChessLogic::getGameState() const {
-    if (isCheckmate(m_currentTurn)) {
-        return GameState::Checkmate;
+void ChessLogic::generateAllLegalMoves(Color color, MoveList& moves) const {
+    LegalityInfo info = m_board.legalityInfo(color);
+    Bitboard pieces = m_board.getPieces(color);
+    while (pieces) {
+        generateLegalMoves(squarePosition(popLsb(pieces)), info, moves);
     }
-    if (isStalemate(m_currentTurn)) {
-        return GameState::Stalemate;
+}
+
+GameState ChessLogic::getGameState() const {
+    return positionCache().state;
+}
+
+int ChessLogic::countRepetitions() const {
+    // Seules les positions depuis le dernier coup irréversible, avec le même camp au
+    // trait (un coup sur deux), peuvent être identiques : simples comparaisons de clés
+    std::uint64_t hash = m_board.getHash();
+    int count = 0;
+    int first = static_cast<int>(m_moveHistory.size()) - m_halfmoveClock;
+    for (int i = static_cast<int>(m_moveHistory.size()) - 2; i >= std::max(first, 0); i -= 2) {
+        if (m_moveHistory[i].hash == hash) {
+            ++count;
+        }
     }
-    if (isInCheck(m_currentTurn)) {
-        return GameState::Check;
+    return count;
+}
+
+std::vector<std::uint64_t> ChessLogic::getRepetitionWindow() const {
+    std::vector<std::uint64_t> keys;
+    std::size_t first = m_moveHistory.size() - std::min<std::size_t>(m_halfmoveClock, m_moveHistory.size());
+    for (std::size_t i = first; i < m_moveHistory.size(); ++i) {
+        keys.push_back(m_moveHistory[i].hash);
     }
-    return GameState::Playing;
+    return keys;
 }
 
 bool ChessLogic::isAttacked(const Position& pos, Color byColor) const {
-    std::vector<Position> attackers = m_board.findPieces(byColor);
-    
-    for (const Position& attackerPos : attackers) {
-        const Piece& attacker = m_board.getPiece(attackerPos);
-        
-        int rowDiff = pos.row - attackerPos.row;
-        int colDiff = pos.col - attackerPos.col;
-        int absRowDiff = std::abs(rowDiff);
-        int absColDiff = std::abs(colDiff);
-        
-        switch (attacker.getType()) {
-            case PieceType::Pawn: {
-                int direction = (byColor == Color::White) ? -1 : 1;
-                if (rowDiff == direction && absColDiff == 1) {
-                    return true;
-                }
-                break;
-            }
-            case PieceType::Knight: {
-                if ((absRowDiff == 2 && absColDiff == 1) || 
-                    (absRowDiff == 1 && absColDiff == 2)) {
-                    return true;
-                }
-                break;
-            }
-            case PieceType::Bishop: {
-                if (absRowDiff == absColDiff && absRowDiff > 0) {
-                    // Check path is clear
-                    int rowStep = (rowDiff > 0) ? 1 : -1;
-                    int colStep = (colDiff > 0) ? 1 : -1;
-                    bool pathClear = true;
-                    for (int i = 1; i < absRowDiff; ++i) {
-                        if (!m_board.getPiece(attackerPos.row + i * rowStep, 
-                                              attackerPos.col + i * colStep).isEmpty()) {
-                            pathClear = false;
-                            break;
-                        }
-                    }
-                    if (pathClear) return true;
-                }
-                break;
-            }
-            case PieceType::Rook: {
-                if ((rowDiff == 0 || colDiff == 0) && (absRowDiff + absColDiff > 0)) {
-                    int rowStep = (rowDiff == 0) ? 0 : (rowDiff > 0 ? 1 : -1);
-                    int colStep = (colDiff == 0) ? 0 : (colDiff > 0 ? 1 : -1);
-                    int steps = std::max(absRowDiff, absColDiff);
-                    bool pathClear = true;
-                    for (int i = 1; i < steps; ++i) {
-                        if (!m_board.getPiece(attackerPos.row + i * rowStep, 
-                                              attackerPos.col + i * colStep).isEmpty()) {
-                            pathClear = false;
-                            break;
-                        }
-                    }
-                    if (pathClear) return true;
-                }
-                break;
-            }
-            case PieceType::Queen: {
-                bool isDiagonal = (absRowDiff == absColDiff && absRowDiff > 0);
-                bool isStraight = ((rowDiff == 0 || colDiff == 0) && (absRowDiff + absColDiff > 0));
-                if (isDiagonal || isStraight) {
-                    int rowStep = (rowDiff == 0) ? 0 : (rowDiff > 0 ? 1 : -1);
-                    int colStep = (colDiff == 0) ? 0 : (colDiff > 0 ? 1 : -1);
-                    int steps = std::max(absRowDiff, absColDiff);
-                    bool pathClear = true;
-                    for (int i = 1; i < steps; ++i) {
-                        if (!m_board.getPiece(attackerPos.row + i * rowStep, 
-                                              attackerPos.col + i * colStep).isEmpty()) {
-                            pathClear = false;
-                            break;
-                        }
-                    }
-                    if (pathClear) return true;
-                }
-                break;
-            }
-            case PieceType::King: {
-                if (absRowDiff <= 1 && absColDiff <= 1 && (absRowDiff + absColDiff > 0)) {
-                    return true;
-                }
-                break;
-            }
-            default:
-                break;
-        }
+    return m_board.isAttacked(pos, byColor);
+}
+
+std::uint64_t ChessLogic::perft(int depth) {
+    if (depth == 0) return 1;
+    
+    // Generated directly: the per-position cache only follows makeMove/undoMove
+    MoveList moves;
+    generateAllLegalMoves(m_currentTurn, moves);
+    if (depth == 1) return moves.size();
+    
+    // Bypass makeMove: the moves are already known to be legal
+    std::uint64_t nodes = 0;
+    for (const Move& move : moves) {
+        MoveRecord record = m_board.applyMove(move);
+        m_currentTurn = opponentOf(m_currentTurn);
+        nodes += perft(depth - 1);
+        m_board.revertMove(record);
+        m_currentTurn = opponentOf(m_currentTurn);
     }
-    
-    return false;
+    return nodes;
 }
 
-std::vector<Move> ChessLogic::getPseudoLegalMoves(const Position& pos) const {
+void ChessLogic::getPseudoLegalMoves(const Position& pos, MoveList& moves) const {
     const Piece& piece = m_board.getPiece(pos);
     
     switch (piece.getType()) {
-        case PieceType::Pawn:   return getPawnMoves(pos);
-        case PieceType::Knight: return getKnightMoves(pos);
-        case PieceType::Bishop: return getBishopMoves(pos);
-        case PieceType::Rook:   return getRookMoves(pos);
-        case PieceType::Queen:  return getQueenMoves(pos);
-        case PieceType::King:   return getKingMoves(pos);
-        default: return {};
+        case PieceType::Pawn:   getPawnMoves(pos, moves); break;
+        case PieceType::Knight: getKnightMoves(pos, moves); break;
+        case PieceType::Bishop: getBishopMoves(pos, moves); break;
+        case PieceType::Rook:   getRookMoves(pos, moves); break;
+        case PieceType::Queen:  getQueenMoves(pos, moves); break;
+        case PieceType::King:   getKingMoves(pos, moves); break;
+        default: break;
     }
 }
 
-std::vector<Move> ChessLogic::getPawnMoves(const Position& pos) const {
-    std::vector<Move> moves;
+void ChessLogic::getPawnMoves(const Position& pos, MoveList& moves) const {
     const Piece& pawn = m_board.getPiece(pos);
     Color color = pawn.getColor();
     int direction = (color == Color::White) ? -1 : 1;
@@ -413,12 +331,9 @@ std::vector<Move> ChessLogic::getPawnMoves(const Position& pos) const {
             }
         }
     }
-    
-    return moves;
 }
 
-std::vector<Move> ChessLogic::getKnightMoves(const Position& pos) const {
-    std::vector<Move> moves;
+void ChessLogic::getKnightMoves(const Position& pos, MoveList& moves) const {
     const Piece& knight = m_board.getPiece(pos);
     Color color = knight.getColor();
     
@@ -435,25 +350,25 @@ std::vector<Move> ChessLogic::getKnightMoves(const Position& pos) const {
             moves.push_back(move);
         }
     }
-    
-    return moves;
 }
 
-std::vector<Move> ChessLogic::getBishopMoves(const Position& pos) const {
-    return getSlidingMoves(pos, {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}});
+void ChessLogic::getBishopMoves(const Position& pos, MoveList& moves) const {
+    static constexpr int directions[][2] = {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+    getSlidingMoves(pos, directions, 4, moves);
 }
 
-std::vector<Move> ChessLogic::getRookMoves(const Position& pos) const {
-    return getSlidingMoves(pos, {{-1, 0}, {1, 0}, {0, -1}, {0, 1}});
+void ChessLogic::getRookMoves(const Position& pos, MoveList& moves) const {
+    static constexpr int directions[][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    getSlidingMoves(pos, directions, 4, moves);
 }
 
-std::vector<Move> ChessLogic::getQueenMoves(const Position& pos) const {
-    return getSlidingMoves(pos, {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, 
-                                  {0, 1}, {1, -1}, {1, 0}, {1, 1}});
+void ChessLogic::getQueenMoves(const Position& pos, MoveList& moves) const {
+    static constexpr int directions[][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, 
+                                            {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+    getSlidingMoves(pos, directions, 8, moves);
 }
 
-std::vector<Move> ChessLogic::getKingMoves(const Position& pos) const {
-    std::vector<Move> moves;
+void ChessLogic::getKingMoves(const Position& pos, MoveList& moves) const {
     const Piece& king = m_board.getPiece(pos);
     Color color = king.getColor();
     
@@ -510,21 +425,18 @@ std::vector<Move> ChessLogic::getKingMoves(const Position& pos) const {
             }
         }
     }
-    
-    return moves;
 }
 
-std::vector<Move> ChessLogic::getSlidingMoves(const Position& pos, 
-                                              const std::vector<std::pair<int, int>>& directions) const {
-    std::vector<Move> moves;
+void ChessLogic::getSlidingMoves(const Position& pos, const int (*directions)[2], int count,
+                                 MoveList& moves) const {
     const Piece& piece = m_board.getPiece(pos);
     Color color = piece.getColor();
     
-    for (const auto& dir : directions) {
+    for (int d = 0; d < count; ++d) {
         Position target = pos;
         while (true) {
-            target.row += dir.first;
-            target.col += dir.second;
+            target.row += directions[d][0];
+            target.col += directions[d][1];
             
             if (!target.isValid()) break;
             
@@ -540,45 +452,6 @@ std::vector<Move> ChessLogic::getSlidingMoves(const Position& pos,
             }
         }
     }
-    
-    return moves;
-}
-
-bool ChessLogic::wouldBeInCheck(const Move& move) const {
-    // Make a copy of the board state and simulate the move
-    Board& board = const_cast<Board&>(m_board);
-    const Piece& movingPiece = board.getPiece(move.from);
-    Color color = movingPiece.getColor();
-    
-    // Save state
-    Piece capturedPiece = board.getPiece(move.to);
-    Piece enPassantCaptured;
-    Position enPassantPos = {-1, -1};
-    
-    if (move.isEnPassant) {
-        enPassantPos = {move.from.row, move.to.col};
-        enPassantCaptured = board.getPiece(enPassantPos);
-        board.removePiece(enPassantPos);
-    }
-    
-    // Make move
-    board.movePiece(move.from, move.to);
-    
-    // Check if king is in check
-    Position kingPos = board.findKing(color);
-    Color opponent = (color == Color::White) ? Color::Black : Color::White;
-    bool inCheck = isAttacked(kingPos, opponent);
-    
-    // Undo move
-    board.movePiece(move.to, move.from);
-    board.getPiece(move.from).setMoved(movingPiece.hasMoved());
-    board.setPiece(move.to, capturedPiece);
-    
-    if (move.isEnPassant) {
-        board.setPiece(enPassantPos, enPassantCaptured);
-    }
-    
-    return inCheck;
 }
 
 } // namespace Chess
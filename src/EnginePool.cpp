@@ -0,0 +1,108 @@
+#include "EnginePool.hpp"
+#include <algorithm>
+
+namespace Chess {
+
+EnginePool::EnginePool(int instances, std::size_t hashMegabytes)
+    : m_stopping(false) {
+    if (instances <= 0) {
+        instances = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    for (int i = 0; i < instances; ++i) {
+        auto instance = std::make_unique<Instance>();
+        instance->ai.setDifficulty(AIDifficulty::Master);
+        instance->ai.setHashSize(hashMegabytes);
+        m_instances.push_back(std::move(instance));
+    }
+    for (auto& instance : m_instances) {
+        m_workers.emplace_back(&EnginePool::workerLoop, this, std::ref(*instance));
+    }
+}
+
+EnginePool::~EnginePool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeUp.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+std::future<AnalysisResult> EnginePool::submit(const std::string& fen, const AnalysisLimits& limits) {
+    std::future<AnalysisResult> future;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back({fen, limits, std::promise<AnalysisResult>()});
+        future = m_jobs.back().result.get_future();
+    }
+    m_wakeUp.notify_one();
+    return future;
+}
+
+std::vector<AnalysisResult> EnginePool::analyse(const std::vector<std::string>& fens, const AnalysisLimits& limits) {
+    // Tout le lot est en file avant la première attente : chaque moteur libre en prend une
+    std::vector<std::future<AnalysisResult>> futures;
+    futures.reserve(fens.size());
+    for (const std::string& fen : fens) {
+        futures.push_back(submit(fen, limits));
+    }
+
+    std::vector<AnalysisResult> results;
+    results.reserve(fens.size());
+    for (auto& future : futures) {
+        results.push_back(future.get());
+    }
+    return results;
+}
+
+void EnginePool::workerLoop(Instance& instance) {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeUp.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            // Les positions déjà soumises sont encore cherchées avant l'arrêt
+            if (m_jobs.empty()) {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job.result.set_value(run(instance, job.fen, job.limits));
+    }
+}
+
+// Chaque moteur garde sa table d'une position à l'autre : les positions voisines
+// d'un même lot (suite d'une partie) en profitent
+AnalysisResult EnginePool::run(Instance& instance, const std::string& fen, const AnalysisLimits& limits) {
+    AnalysisResult result;
+    result.fen = fen;
+    if (!instance.logic.loadFEN(fen)) {
+        return result;
+    }
+    // Mat ou pat : rien à chercher, la position reste sans coup
+    MoveList moves;
+    instance.logic.getAllLegalMoves(instance.logic.getCurrentTurn(), moves);
+    if (moves.empty()) {
+        return result;
+    }
+
+    instance.ai.setMoveTime(limits.moveTimeMs);
+    instance.ai.setDepthLimit(limits.depth > 0 ? limits.depth : limits.moveTimeMs > 0 ? AIPlayer::MAX_PLY - 1 : 0);
+    Move best = instance.ai.findBestMove(instance.logic.getCurrentTurn());
+
+    const SearchStats& stats = instance.ai.getLastSearchStats();
+    result.valid = true;
+    result.bestMove = best;
+    result.score = stats.score;
+    result.depth = stats.depth;
+    result.nodes = stats.nodes;
+    result.elapsedMs = stats.elapsedMs;
+    result.pv = stats.pv;
+    return result;
+}
+
+} // namespace Chess
@@ -3,12 +3,17 @@
 #include <sstream>
 #include <iomanip>
 #include <random>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <future>
 
 namespace Chess {
 
 Game::Game()
     : m_waitingForPromotion(false)
     , m_gameState(GameState::MainMenu)
+    , m_needsRedraw(true)
     , m_selectedTime(TimeOption::FiveMinutes)
     , m_whiteTime(300.0f)
     , m_blackTime(300.0f)
@@ -17,7 +22,8 @@ Game::Game()
     , m_selectedDifficulty(AIDifficulty::Medium)
     , m_playerColor(Color::White)
     , m_aiThinking(false)
-    , m_aiColor(Color::Black) {
+    , m_aiColor(Color::Black)
+    , m_ponderEnabled(false) {
 }
 
 Game::~Game() = default;
@@ -30,17 +36,25 @@ bool Game::initialize() {
     );
     m_window->setFramerateLimit(60);
     
+    // Police et sons se chargent en tâche de fond pendant que le moteur s'installe
     m_board = std::make_unique<Board>();
     m_board->initialize();
-    m_logic = std::make_unique<ChessLogic>(*m_board);
-    m_aiPlayer = std::make_unique<AIPlayer>(*m_board, *m_logic);
-    
     m_renderer = std::make_unique<Renderer>(*m_window, *m_board);
-    if (!m_renderer->loadResources()) {
+    m_renderer->startLoading();
+    m_soundManager = std::make_unique<SoundManager>();
+    
+    m_logic = std::make_unique<ChessLogic>(*m_board);
+    createAIPlayer();
+    // Tables de finales facultatives (make FATHOM=...) : l'ouverture (état global) parcourt
+    // le dossier, inutile d'attendre pour afficher le menu, resetGame l'attend avant la
+    // première partie
+    m_tablebaseLoading = std::async(std::launch::async, [] { return Tablebase::init(SYZYGY_PATH); });
+    
+    // Le menu n'attend que la police
+    if (!m_renderer->finishLoading()) {
         std::cerr << "Warning: Some resources could not be loaded." << std::endl;
     }
     
-    m_soundManager = std::make_unique<SoundManager>();
     initMenuButtons();
     
     return true;
@@ -81,7 +95,8 @@ void Game::initMenuButtons() {
         {"Facile", AIDifficulty::Easy},
         {"Moyen", AIDifficulty::Medium},
         {"Difficile", AIDifficulty::Hard},
-        {"Expert", AIDifficulty::Expert}
+        {"Expert", AIDifficulty::Expert},
+        {"Maitre", AIDifficulty::Master}
     };
     
     float diffBtnWidth = 100;
@@ -128,58 +143,107 @@ void Game::run() {
         float dt = m_clock.restart().asSeconds();
         processEvents();
         update(dt);
-        render();
+        
+        if (m_needsRedraw) {
+            m_needsRedraw = false;
+            render();
+        } else {
+            waitForEvent();
+        }
+    }
+}
+
+void Game::waitForEvent() {
+    if (const std::optional event = m_window->waitEvent(sf::milliseconds(nextWakeupMs()))) {
+        handleEvent(*event);
     }
 }
 
+int Game::nextWakeupMs() const {
+    bool playing = m_gameState == GameState::Playing || m_gameState == GameState::Check;
+    
+    // A running search is polled for its result
+    if (playing && m_aiThinking) {
+        return AI_POLL_MS;
+    }
+    
+    // The clock shows whole seconds: wake up when the displayed value changes
+    if (playing && m_timerEnabled && !m_waitingForPromotion) {
+        float remaining = (m_logic->getCurrentTurn() == Color::White) ? m_whiteTime : m_blackTime;
+        float untilTick = remaining - std::floor(remaining);
+        if (untilTick <= 0.0f) untilTick = 1.0f;
+        return std::min(IDLE_WAIT_MS, static_cast<int>(untilTick * 1000.0f) + 1);
+    }
+    
+    return IDLE_WAIT_MS;
+}
+
 void Game::processEvents() {
     while (const std::optional event = m_window->pollEvent()) {
-        if (event->is<sf::Event::Closed>()) {
-            m_window->close();
-        }
-        else if (const auto* mouseMoved = event->getIf<sf::Event::MouseMoved>()) {
-            handleMouseMove(mouseMoved->position.x, mouseMoved->position.y);
-        }
-        else if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-            if (keyPressed->code == sf::Keyboard::Key::Escape) {
-                if (m_gameState == GameState::MainMenu) {
-                    m_window->close();
-                } else if (m_gameState == GameState::Playing || m_gameState == GameState::Check) {
-                    m_gameState = GameState::MainMenu;
-                }
-            } else if (keyPressed->code == sf::Keyboard::Key::R && 
-                      (m_gameState == GameState::Playing || m_gameState == GameState::Check)) {
-                resetGame();
-                m_soundManager->playMenuClick();
+        handleEvent(*event);
+    }
+}
+
+void Game::handleEvent(const sf::Event& event) {
+    // Hovering only matters when it changes a button, handleMouseMove decides
+    if (!event.is<sf::Event::MouseMoved>()) {
+        m_needsRedraw = true;
+    }
+    
+    if (event.is<sf::Event::Closed>()) {
+        m_window->close();
+    }
+    else if (const auto* mouseMoved = event.getIf<sf::Event::MouseMoved>()) {
+        handleMouseMove(mouseMoved->position.x, mouseMoved->position.y);
+    }
+    else if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+        if (keyPressed->code == sf::Keyboard::Key::Escape) {
+            if (m_gameState == GameState::MainMenu) {
+                m_window->close();
+            } else if (m_gameState == GameState::Playing || m_gameState == GameState::Check) {
+                m_gameState = GameState::MainMenu;
             }
-            else if (m_waitingForPromotion) {
-                if (keyPressed->code == sf::Keyboard::Key::Q) {
-                    handlePromotion(PieceType::Queen);
-                } else if (keyPressed->code == sf::Keyboard::Key::R) {
-                    handlePromotion(PieceType::Rook);
-                } else if (keyPressed->code == sf::Keyboard::Key::B) {
-                    handlePromotion(PieceType::Bishop);
-                } else if (keyPressed->code == sf::Keyboard::Key::N) {
-                    handlePromotion(PieceType::Knight);
-                }
+        } else if (keyPressed->code == sf::Keyboard::Key::R && 
+                  (m_gameState == GameState::Playing || m_gameState == GameState::Check)) {
+            resetGame();
+            m_soundManager->playMenuClick();
+        } else if (keyPressed->code == sf::Keyboard::Key::P && !m_waitingForPromotion &&
+                  (m_gameState == GameState::Playing || m_gameState == GameState::Check)) {
+            // Réflexion sur le temps de l'adversaire, désactivée par défaut : elle occupe
+            // les threads de l'IA pendant tout le tour du joueur
+            m_ponderEnabled = !m_ponderEnabled;
+            if (!m_ponderEnabled && m_aiPlayer->isPondering()) {
+                m_aiPlayer->cancelSearch();
             }
+            m_soundManager->playMenuClick();
         }
-        else if (const auto* mousePressed = event->getIf<sf::Event::MouseButtonPressed>()) {
-            if (mousePressed->button == sf::Mouse::Button::Left) {
-                if (m_gameState == GameState::MainMenu) {
-                    handleMenuClick(mousePressed->position.x, mousePressed->position.y);
-                } else if (m_gameState == GameState::Checkmate || 
-                          m_gameState == GameState::Stalemate || 
-                          m_gameState == GameState::Draw ||
-                          m_gameState == GameState::WhiteTimeout ||
-                          m_gameState == GameState::BlackTimeout) {
-                    handleMenuClick(mousePressed->position.x, mousePressed->position.y);
-                } else if (!m_renderer->isAnimating() && !m_waitingForPromotion) {
-                    handleClick(mousePressed->position.x, mousePressed->position.y);
-                }
-            } else if (mousePressed->button == sf::Mouse::Button::Right) {
-                deselectPiece();
+        else if (m_waitingForPromotion) {
+            if (keyPressed->code == sf::Keyboard::Key::Q) {
+                handlePromotion(PieceType::Queen);
+            } else if (keyPressed->code == sf::Keyboard::Key::R) {
+                handlePromotion(PieceType::Rook);
+            } else if (keyPressed->code == sf::Keyboard::Key::B) {
+                handlePromotion(PieceType::Bishop);
+            } else if (keyPressed->code == sf::Keyboard::Key::N) {
+                handlePromotion(PieceType::Knight);
+            }
+        }
+    }
+    else if (const auto* mousePressed = event.getIf<sf::Event::MouseButtonPressed>()) {
+        if (mousePressed->button == sf::Mouse::Button::Left) {
+            if (m_gameState == GameState::MainMenu) {
+                handleMenuClick(mousePressed->position.x, mousePressed->position.y);
+            } else if (m_gameState == GameState::Checkmate || 
+                      m_gameState == GameState::Stalemate || 
+                      m_gameState == GameState::Draw ||
+                      m_gameState == GameState::WhiteTimeout ||
+                      m_gameState == GameState::BlackTimeout) {
+                handleMenuClick(mousePressed->position.x, mousePressed->position.y);
+            } else if (!m_renderer->isAnimating() && !m_waitingForPromotion) {
+                handleClick(mousePressed->position.x, mousePressed->position.y);
             }
+        } else if (mousePressed->button == sf::Mouse::Button::Right) {
+            deselectPiece();
         }
     }
 }
@@ -199,11 +263,19 @@ void Game::handleMouseMove(int x, int y) {
     m_pvpButton.hovered = m_pvpButton.bounds.contains(pos);
     m_pvaButton.hovered = m_pvaButton.bounds.contains(pos);
     
+    // Entering or leaving any button changes its look
+    bool hoverChanged = m_playButton.hovered != wasPlayHovered ||
+                        m_restartButton.hovered != wasRestartHovered ||
+                        m_quitButton.hovered != wasQuitHovered ||
+                        m_pvpButton.hovered != wasPvpHovered ||
+                        m_pvaButton.hovered != wasPvaHovered;
+    
     bool anyTimeHovered = false;
     for (auto& btn : m_timeButtons) {
         bool wasHovered = btn.hovered;
         btn.hovered = btn.bounds.contains(pos);
         if (btn.hovered && !wasHovered) anyTimeHovered = true;
+        if (btn.hovered != wasHovered) hoverChanged = true;
     }
     
     bool anyDiffHovered = false;
@@ -211,6 +283,11 @@ void Game::handleMouseMove(int x, int y) {
         bool wasHovered = btn.hovered;
         btn.hovered = btn.bounds.contains(pos);
         if (btn.hovered && !wasHovered) anyDiffHovered = true;
+        if (btn.hovered != wasHovered) hoverChanged = true;
+    }
+    
+    if (hoverChanged) {
+        m_needsRedraw = true;
     }
     
     if ((m_playButton.hovered && !wasPlayHovered) ||
@@ -246,7 +323,8 @@ void Game::handleMenuClick(int x, int y) {
                 AIDifficulty::Easy,
                 AIDifficulty::Medium,
                 AIDifficulty::Hard,
-                AIDifficulty::Expert
+                AIDifficulty::Expert,
+                AIDifficulty::Master
             };
             
             for (size_t i = 0; i < m_difficultyButtons.size(); ++i) {
@@ -308,11 +386,18 @@ void Game::updateTimer(float dt) {
     if (m_gameState != GameState::Playing && m_gameState != GameState::Check) return;
     if (m_waitingForPromotion) return;
     
+    // The clock display only changes when a whole second goes by
+    float& remaining = (m_logic->getCurrentTurn() == Color::White) ? m_whiteTime : m_blackTime;
+    if (static_cast<int>(remaining) != static_cast<int>(remaining - dt)) {
+        m_needsRedraw = true;
+    }
+    
     if (m_logic->getCurrentTurn() == Color::White) {
         m_whiteTime -= dt;
         if (m_whiteTime <= 0) {
             m_whiteTime = 0;
             m_gameState = GameState::WhiteTimeout;
+            m_needsRedraw = true;
             m_soundManager->playGameOver();
         }
     } else {
@@ -320,12 +405,17 @@ void Game::updateTimer(float dt) {
         if (m_blackTime <= 0) {
             m_blackTime = 0;
             m_gameState = GameState::BlackTimeout;
+            m_needsRedraw = true;
             m_soundManager->playGameOver();
         }
     }
 }
 
 void Game::update(float dt) {
+    // One more frame once the animation ends, to draw the piece at rest
+    if (m_renderer->isAnimating()) {
+        m_needsRedraw = true;
+    }
     m_renderer->updateAnimation(dt);
     
     if (m_gameState == GameState::Playing || m_gameState == GameState::Check) {
@@ -343,6 +433,7 @@ void Game::update(float dt) {
                     m_soundManager->playCheck();
                 }
                 m_gameState = newState;
+                m_needsRedraw = true;
             }
         }
     }
@@ -817,6 +908,7 @@ void Game::handlePromotion(PieceType type) {
     
     if (m_logic->makeMove(m_pendingPromotionMove)) {
         m_soundManager->playMove();
+        onPlayerMove(m_pendingPromotionMove);
     }
     
     m_waitingForPromotion = false;
@@ -863,6 +955,7 @@ void Game::tryMove(const Position& to) {
                 } else {
                     m_soundManager->playMove();
                 }
+                onPlayerMove(move);
             }
             
             deselectPiece();
@@ -871,10 +964,25 @@ void Game::tryMove(const Position& to) {
     }
 }
 
+void Game::createAIPlayer() {
+    m_aiPlayer = std::make_unique<AIPlayer>(*m_board, *m_logic);
+    // La moitié des cœurs : l'interface et le reste du système gardent de quoi tourner
+    m_aiPlayer->setThreadCount(static_cast<int>(std::max(1u, std::thread::hardware_concurrency() / 2)));
+    // Livre d'ouvertures facultatif (make book)
+    m_aiPlayer->loadOpeningBook(BOOK_PATH);
+}
+
 void Game::resetGame() {
+    // Arrêter une éventuelle recherche en cours avant de toucher au board
+    if (m_aiPlayer) {
+        m_aiPlayer->cancelSearch();
+    }
+    if (m_tablebaseLoading.valid()) {
+        m_tablebaseLoading.get();
+    }
     m_board->initialize();
     m_logic = std::make_unique<ChessLogic>(*m_board);
-    m_aiPlayer = std::make_unique<AIPlayer>(*m_board, *m_logic);
+    createAIPlayer();
     m_aiPlayer->setDifficulty(m_selectedDifficulty);
     deselectPiece();
     m_waitingForPromotion = false;
@@ -899,11 +1007,32 @@ void Game::resetGame() {
     m_blackTime = timeInSeconds;
 }
 
-void Game::makeAIMove() {
+void Game::updateAIClock() {
+    // Le budget de réflexion suit la pendule de l'IA pour ne pas perdre au temps
+    if (m_timerEnabled) {
+        float remaining = (m_aiColor == Color::White) ? m_whiteTime : m_blackTime;
+        m_aiPlayer->setRemainingTime(static_cast<int>(remaining * 1000.0f));
+    }
+}
+
+void Game::startAIMove() {
     if (!m_aiPlayer) return;
     
-    Move bestMove = m_aiPlayer->findBestMove(m_aiColor);
+    updateAIClock();
+    m_aiPlayer->startSearch(m_aiColor);
+}
+
+void Game::onPlayerMove(const Move& move) {
+    if (m_gameMode != GameMode::PlayerVsAI || !m_aiPlayer || !m_aiPlayer->isPondering()) return;
     
+    // Coup prévu : la réflexion entamée devient la recherche du coup de l'IA,
+    // sinon elle est abandonnée et updateAI en relance une
+    updateAIClock();
+    m_aiThinking = m_aiPlayer->ponderHit(move);
+}
+
+void Game::makeAIMove(const Move& bestMove) {
+    m_needsRedraw = true;
     if (bestMove.from.isValid() && bestMove.to.isValid()) {
         bool isCapture = !m_board->getPiece(bestMove.to).isEmpty() || bestMove.isEnPassant;
         
@@ -933,11 +1062,21 @@ void Game::updateAI() {
         m_gameState == GameState::WhiteTimeout ||
         m_gameState == GameState::BlackTimeout) return;
     
-    // Toujours synchrone — l'IA travaille sur des copies, pas besoin de thread
+    // La recherche tourne sur un thread : la fenêtre continue d'être rendue
+    // et le coup est joué dès que le résultat est prêt
     if (!m_aiThinking) {
         m_aiThinking = true;
-        makeAIMove();
+        startAIMove();
+    } else if (m_aiPlayer->isSearchDone()) {
         m_aiThinking = false;
+        Move bestMove = m_aiPlayer->getSearchResult();
+        makeAIMove(bestMove);
+        
+        // Réfléchir pendant le temps de l'adversaire sur la réponse attendue
+        Move expectedReply = m_aiPlayer->getExpectedReply();
+        if (m_ponderEnabled && m_logic->getCurrentTurn() != m_aiColor && m_logic->isLegalMove(expectedReply)) {
+            m_aiPlayer->startPondering(m_aiColor, expectedReply);
+        }
     }
 }
 
@@ -0,0 +1,163 @@
+#include "OpeningBook.hpp"
+#include <algorithm>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Chess {
+
+namespace {
+
+std::uint64_t readBigEndian(const unsigned char* bytes, int count) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < count; ++i) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+void writeBigEndian(std::ostream& out, std::uint64_t value, int count) {
+    for (int i = count - 1; i >= 0; --i) {
+        out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+// Polyglot numérote les cases depuis a1 (rangée 0 = rang 1), le board depuis a8
+int toPolyglotSquare(int sq) { return (7 - (sq >> 3)) * 8 + (sq & 7); }
+int fromPolyglotSquare(int sq) { return (7 - (sq >> 3)) * 8 + (sq & 7); }
+
+} // namespace
+
+OpeningBook::~OpeningBook() {
+    close();
+}
+
+bool OpeningBook::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(ENTRY_SIZE)) {
+        ::close(fd);
+        return false;
+    }
+
+    // La projection reste valide après la fermeture du descripteur
+    std::size_t length = static_cast<std::size_t>(info.st_size);
+    void* data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    m_data = static_cast<const unsigned char*>(data);
+    m_mappedLength = length;
+    m_count = length / ENTRY_SIZE;
+    return true;
+}
+
+void OpeningBook::close() {
+    if (m_data) {
+        munmap(const_cast<unsigned char*>(m_data), m_mappedLength);
+        m_data = nullptr;
+        m_mappedLength = 0;
+        m_count = 0;
+    }
+}
+
+std::uint64_t OpeningBook::keyAt(std::size_t index) const {
+    return readBigEndian(m_data + index * ENTRY_SIZE, 8);
+}
+
+std::vector<BookEntry> OpeningBook::probe(const Board& board) const {
+    std::vector<BookEntry> entries;
+    if (!m_data) {
+        return entries;
+    }
+
+    // Première entrée dont la clé n'est pas inférieure à celle de la position
+    std::uint64_t key = board.getHash();
+    std::size_t low = 0;
+    std::size_t high = m_count;
+    while (low < high) {
+        std::size_t mid = low + (high - low) / 2;
+        if (keyAt(mid) < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    for (std::size_t i = low; i < m_count && keyAt(i) == key; ++i) {
+        const unsigned char* entry = m_data + i * ENTRY_SIZE;
+        BookEntry bookEntry;
+        bookEntry.key = key;
+        bookEntry.move = decodeMove(board, static_cast<std::uint16_t>(readBigEndian(entry + 8, 2)));
+        bookEntry.weight = static_cast<std::uint16_t>(readBigEndian(entry + 10, 2));
+        entries.push_back(bookEntry);
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const BookEntry& a, const BookEntry& b) {
+        return a.weight > b.weight;
+    });
+    return entries;
+}
+
+bool OpeningBook::write(const std::string& path, std::vector<BookEntry> entries) {
+    std::sort(entries.begin(), entries.end(), [](const BookEntry& a, const BookEntry& b) {
+        return a.key != b.key ? a.key < b.key : a.weight > b.weight;
+    });
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    for (const BookEntry& entry : entries) {
+        writeBigEndian(out, entry.key, 8);
+        writeBigEndian(out, encodeMove(entry.move), 2);
+        writeBigEndian(out, entry.weight, 2);
+        writeBigEndian(out, 0, 4);
+    }
+    return static_cast<bool>(out);
+}
+
+// départ (6 bits) << 6 | arrivée (6 bits) | promotion (1 cavalier ... 4 dame) << 12
+std::uint16_t OpeningBook::encodeMove(PackedMove move) {
+    int to = move.to();
+    if (move.isCastling()) {
+        // Polyglot note le roque par la case de la tour
+        to = (to & ~7) | (move.flags() == PackedMove::KingCastle ? 7 : 0);
+    }
+
+    int promotion = move.isPromotion() ? typeIndex(move.promotion()) - typeIndex(PieceType::Pawn) : 0;
+    return static_cast<std::uint16_t>(toPolyglotSquare(to) | (toPolyglotSquare(move.from()) << 6) |
+                                      (promotion << 12));
+}
+
+PackedMove OpeningBook::decodeMove(const Board& board, std::uint16_t raw) {
+    int to = fromPolyglotSquare(raw & 63);
+    int from = fromPolyglotSquare((raw >> 6) & 63);
+    int promotion = (raw >> 12) & 7;
+
+    const Piece& piece = board.getPiece(from);
+    const Piece& target = board.getPiece(to);
+    if (piece.getType() == PieceType::King && target.getType() == PieceType::Rook &&
+        target.getColor() == piece.getColor()) {
+        bool kingside = (to & 7) > (from & 7);
+        return PackedMove(from, (from & ~7) | (kingside ? 6 : 2),
+                          kingside ? PackedMove::KingCastle : PackedMove::QueenCastle);
+    }
+
+    if (promotion >= 1 && promotion <= 4) {
+        return PackedMove(from, to, PackedMove::Promotion | (promotion - 1));
+    }
+    return PackedMove(from, to, PackedMove::Quiet);
+}
+
+} // namespace Chess
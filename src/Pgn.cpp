@@ -0,0 +1,521 @@
+#include "Pgn.hpp"
+#include "MoveList.hpp"
+#include <algorithm>
+#include <cctype>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace Chess {
+
+namespace {
+
+const char* const ROSTER[7] = {"Event", "Site", "Date", "Round", "White", "Black", "Result"};
+const char* const ROSTER_DEFAULTS[7] = {"?", "?", "????.??.??", "?", "?", "?", "*"};
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool isResult(std::string_view token) {
+    return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+}
+
+char pieceLetter(PieceType type) {
+    switch (type) {
+        case PieceType::Knight: return 'N';
+        case PieceType::Bishop: return 'B';
+        case PieceType::Rook: return 'R';
+        case PieceType::Queen: return 'Q';
+        case PieceType::King: return 'K';
+        default: return 0;
+    }
+}
+
+PieceType letterPiece(char c) {
+    switch (c) {
+        case 'N': return PieceType::Knight;
+        case 'B': return PieceType::Bishop;
+        case 'R': return PieceType::Rook;
+        case 'Q': return PieceType::Queen;
+        case 'K': return PieceType::King;
+        default: return PieceType::None;
+    }
+}
+
+char fileChar(int col) { return static_cast<char>('a' + col); }
+char rankChar(int row) { return static_cast<char>('8' - row); }
+
+// SAN without its check suffix; move must be one of the legal moves
+std::string sanWithoutSuffix(const Board& board, const MoveList& legalMoves, const Move& move) {
+    const Move* played = nullptr;
+    for (const Move& legal : legalMoves) {
+        if (legal == move) played = &legal;
+    }
+    if (!played) return std::string();
+
+    if (played->isCastling) {
+        return played->to.col > played->from.col ? "O-O" : "O-O-O";
+    }
+
+    std::string san;
+    PieceType type = board.getPiece(played->from).getType();
+    bool capture = played->isCapture || played->isEnPassant;
+
+    if (type == PieceType::Pawn) {
+        if (capture) {
+            san += fileChar(played->from.col);
+        }
+    } else {
+        san += pieceLetter(type);
+        // Other pieces of the same kind reaching the same square: file first, then rank
+        bool ambiguous = false, sameFile = false, sameRank = false;
+        for (const Move& other : legalMoves) {
+            if (other.to != played->to || other.from == played->from ||
+                board.getPiece(other.from).getType() != type) {
+                continue;
+            }
+            ambiguous = true;
+            sameFile |= other.from.col == played->from.col;
+            sameRank |= other.from.row == played->from.row;
+        }
+        if (ambiguous) {
+            if (!sameFile) {
+                san += fileChar(played->from.col);
+            } else if (!sameRank) {
+                san += rankChar(played->from.row);
+            } else {
+                san += fileChar(played->from.col);
+                san += rankChar(played->from.row);
+            }
+        }
+    }
+
+    if (capture) san += 'x';
+    san += fileChar(played->to.col);
+    san += rankChar(played->to.row);
+    if (played->promotion != PieceType::None) {
+        san += '=';
+        san += pieceLetter(played->promotion);
+    }
+    return san;
+}
+
+void appendEscaped(std::ostream& out, const std::string& value) {
+    for (char c : value) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+}
+
+} // namespace
+
+std::string PgnGame::tag(std::string_view name) const {
+    for (const auto& [key, value] : tags) {
+        if (key == name) return value;
+    }
+    return std::string();
+}
+
+void PgnGame::setTag(const std::string& name, const std::string& value) {
+    for (auto& [key, current] : tags) {
+        if (key == name) {
+            current = value;
+            return;
+        }
+    }
+    tags.emplace_back(name, value);
+}
+
+std::string PgnGame::startFEN() const {
+    std::string fen = tag("FEN");
+    return fen.empty() ? Pgn::START_FEN : fen;
+}
+
+namespace Pgn {
+
+const char* const START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+std::string toSan(ChessLogic& logic, const Move& move) {
+    MoveList legalMoves;
+    logic.getAllLegalMoves(logic.getCurrentTurn(), legalMoves);
+    std::string san = sanWithoutSuffix(logic.getBoard(), legalMoves, move);
+    if (san.empty() || !logic.makeMove(move)) {
+        return std::string();
+    }
+    GameState state = logic.getGameState();
+    if (state == GameState::Checkmate) {
+        san += '#';
+    } else if (state == GameState::Check) {
+        san += '+';
+    }
+    logic.undoMove();
+    return san;
+}
+
+bool parseSan(const ChessLogic& logic, std::string_view san, Move& move) {
+    // Suffixes and annotations: check, mate, "!", "?", and the "e.p." some files add
+    if (san.size() > 4 && san.substr(san.size() - 4) == "e.p.") {
+        san.remove_suffix(4);
+    }
+    while (!san.empty() && (san.back() == '+' || san.back() == '#' || san.back() == '!' || san.back() == '?')) {
+        san.remove_suffix(1);
+    }
+    if (san.size() < 2) return false;
+
+    MoveList legalMoves;
+    logic.getAllLegalMoves(logic.getCurrentTurn(), legalMoves);
+    const Board& board = logic.getBoard();
+
+    if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0") {
+        bool kingside = san.size() == 3;
+        for (const Move& legal : legalMoves) {
+            if (legal.isCastling && (legal.to.col > legal.from.col) == kingside) {
+                move = legal;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Promotion at the end: "e8=Q", or "e8Q" / "e8q" without the sign
+    PieceType promotion = PieceType::None;
+    char last = san.back();
+    if (san.size() >= 3 && std::string_view("QRBNqrbn").find(last) != std::string_view::npos) {
+        char before = san[san.size() - 2];
+        if (before == '=' || before == '1' || before == '8') {
+            promotion = letterPiece(static_cast<char>(std::toupper(static_cast<unsigned char>(last))));
+            san.remove_suffix(before == '=' ? 2 : 1);
+        }
+    }
+
+    if (san.size() < 2) return false;
+    char toFile = san[san.size() - 2];
+    char toRank = san[san.size() - 1];
+    if (toFile < 'a' || toFile > 'h' || toRank < '1' || toRank > '8') return false;
+    Position to = {'8' - toRank, toFile - 'a'};
+    san.remove_suffix(2);
+
+    PieceType type = PieceType::Pawn;
+    if (!san.empty() && letterPiece(san.front()) != PieceType::None) {
+        type = letterPiece(san.front());
+        san.remove_prefix(1);
+    }
+
+    // What is left disambiguates: origin file and/or rank, capture and dash ignored
+    int fromCol = -1, fromRow = -1;
+    for (char c : san) {
+        if (c >= 'a' && c <= 'h') {
+            fromCol = c - 'a';
+        } else if (c >= '1' && c <= '8') {
+            fromRow = '8' - c;
+        } else if (c != 'x' && c != '-' && c != ':') {
+            return false;
+        }
+    }
+
+    const Move* found = nullptr;
+    for (const Move& legal : legalMoves) {
+        if (legal.to != to || legal.promotion != promotion ||
+            board.getPiece(legal.from).getType() != type ||
+            (fromCol >= 0 && legal.from.col != fromCol) || (fromRow >= 0 && legal.from.row != fromRow)) {
+            continue;
+        }
+        if (found) return false;
+        found = &legal;
+    }
+    if (!found) return false;
+    move = *found;
+    return true;
+}
+
+void write(std::ostream& out, const PgnGame& game) {
+    for (int i = 0; i < 7; ++i) {
+        std::string value = i == 6 ? game.result : game.tag(ROSTER[i]);
+        out << '[' << ROSTER[i] << " \"";
+        appendEscaped(out, value.empty() ? ROSTER_DEFAULTS[i] : value);
+        out << "\"]\n";
+    }
+    for (const auto& [key, value] : game.tags) {
+        if (std::find_if(std::begin(ROSTER), std::end(ROSTER), [&key](const char* name) { return key == name; })
+            != std::end(ROSTER)) {
+            continue;
+        }
+        out << '[' << key << " \"";
+        appendEscaped(out, value);
+        out << "\"]\n";
+    }
+    out << '\n';
+
+    Board board;
+    ChessLogic logic(board);
+    std::string line;
+    auto emit = [&](const std::string& token) {
+        if (!line.empty() && line.size() + 1 + token.size() > 80) {
+            out << line << '\n';
+            line.clear();
+        }
+        if (!line.empty()) line += ' ';
+        line += token;
+    };
+
+    if (logic.loadFEN(game.startFEN())) {
+        bool first = true;
+        for (const Move& move : game.moves) {
+            bool white = logic.getCurrentTurn() == Color::White;
+            std::string token;
+            if (white || first) {
+                token = std::to_string(logic.getFullmoveNumber()) + (white ? "." : "...");
+                emit(token);
+            }
+            std::string san = toSan(logic, move);
+            if (san.empty() || !logic.makeMove(move)) break;
+            emit(san);
+            first = false;
+        }
+    }
+    emit(game.result);
+    out << line << "\n\n";
+}
+
+PgnGame fromLogic(const ChessLogic& logic, const std::string& startFEN,
+                  const std::vector<std::pair<std::string, std::string>>& tags) {
+    PgnGame game;
+    game.tags = tags;
+    if (startFEN != START_FEN) {
+        game.setTag("SetUp", "1");
+        game.setTag("FEN", startFEN);
+    }
+    game.moves = logic.getMoveHistory();
+
+    switch (logic.getGameState()) {
+        case GameState::Checkmate:
+            game.result = logic.getCurrentTurn() == Color::White ? "0-1" : "1-0";
+            break;
+        case GameState::Stalemate:
+        case GameState::Draw:
+            game.result = "1/2-1/2";
+            break;
+        case GameState::WhiteTimeout:
+            game.result = "0-1";
+            break;
+        case GameState::BlackTimeout:
+            game.result = "1-0";
+            break;
+        default:
+            game.result = "*";
+            break;
+    }
+    game.setTag("Result", game.result);
+    return game;
+}
+
+} // namespace Pgn
+
+PgnReader::PgnReader()
+    : m_pos(0)
+    , m_mapping(nullptr)
+    , m_mappingSize(0)
+    , m_logic(m_board) {}
+
+PgnReader::~PgnReader() {
+    close();
+}
+
+bool PgnReader::open(const std::string& path) {
+    close();
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    if (size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        // Read once from start to end: let the kernel prefetch and drop pages behind us
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        m_mapping = mapping;
+        m_mappingSize = size;
+        m_text = std::string_view(static_cast<const char*>(mapping), size);
+    }
+    ::close(fd);
+#else
+    // No mmap here: the file is read whole
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    auto* buffer = new std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    m_mapping = buffer;
+    m_mappingSize = buffer->size();
+    m_text = *buffer;
+#endif
+    m_pos = 0;
+    return true;
+}
+
+void PgnReader::openBuffer(std::string_view text) {
+    close();
+    m_text = text;
+    m_pos = 0;
+}
+
+void PgnReader::close() {
+    if (m_mapping) {
+#ifndef _WIN32
+        munmap(m_mapping, m_mappingSize);
+#else
+        delete static_cast<std::string*>(m_mapping);
+#endif
+    }
+    m_mapping = nullptr;
+    m_mappingSize = 0;
+    m_text = std::string_view();
+    m_pos = 0;
+}
+
+// Whitespace, "{...}" and ";" comments, and "%" escape lines
+void PgnReader::skipSpaceAndComments() {
+    while (m_pos < m_text.size()) {
+        char c = m_text[m_pos];
+        if (isSpace(c)) {
+            ++m_pos;
+        } else if (c == '{') {
+            std::size_t end = m_text.find('}', m_pos);
+            m_pos = end == std::string_view::npos ? m_text.size() : end + 1;
+        } else if (c == ';' || (c == '%' && (m_pos == 0 || m_text[m_pos - 1] == '\n'))) {
+            std::size_t end = m_text.find('\n', m_pos);
+            m_pos = end == std::string_view::npos ? m_text.size() : end + 1;
+        } else {
+            break;
+        }
+    }
+}
+
+// [Name "value"], with \" and \\ escapes in the value
+bool PgnReader::readTag(PgnGame& game) {
+    ++m_pos;
+    std::size_t start = m_pos;
+    while (m_pos < m_text.size() && !isSpace(m_text[m_pos]) && m_text[m_pos] != '"' && m_text[m_pos] != ']') {
+        ++m_pos;
+    }
+    std::string name(m_text.substr(start, m_pos - start));
+    while (m_pos < m_text.size() && isSpace(m_text[m_pos])) ++m_pos;
+
+    std::string value;
+    if (m_pos < m_text.size() && m_text[m_pos] == '"') {
+        ++m_pos;
+        while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+            if (m_text[m_pos] == '\\' && m_pos + 1 < m_text.size()) ++m_pos;
+            value += m_text[m_pos++];
+        }
+        ++m_pos;
+    }
+
+    std::size_t end = m_text.find(']', m_pos);
+    if (end == std::string_view::npos) {
+        m_pos = m_text.size();
+        return false;
+    }
+    m_pos = end + 1;
+    if (!name.empty()) game.setTag(name, value);
+    return true;
+}
+
+std::string_view PgnReader::readToken() {
+    std::size_t start = m_pos;
+    while (m_pos < m_text.size()) {
+        char c = m_text[m_pos];
+        if (isSpace(c) || c == '{' || c == '}' || c == '(' || c == ')' || c == ';' || c == '[') break;
+        ++m_pos;
+    }
+    if (m_pos == start) ++m_pos;  // lone delimiter, consumed to guarantee progress
+    return m_text.substr(start, m_pos - start);
+}
+
+// Recursive annotation variation, itself possibly nested: not part of the game
+void PgnReader::skipVariation() {
+    int level = 0;
+    while (m_pos < m_text.size()) {
+        skipSpaceAndComments();
+        if (m_pos >= m_text.size()) break;
+        char c = m_text[m_pos];
+        if (c == '(') {
+            ++level;
+            ++m_pos;
+        } else if (c == ')') {
+            ++m_pos;
+            if (--level == 0) return;
+        } else {
+            readToken();
+        }
+    }
+}
+
+bool PgnReader::next(PgnGame& game) {
+    game = PgnGame();
+    skipSpaceAndComments();
+    if (m_pos >= m_text.size()) return false;
+
+    while (m_pos < m_text.size() && m_text[m_pos] == '[') {
+        readTag(game);
+        skipSpaceAndComments();
+    }
+    if (!m_logic.loadFEN(game.startFEN())) {
+        game.valid = false;
+        game.error = "invalid FEN tag";
+    }
+    std::string tagResult = game.tag("Result");
+    if (isResult(tagResult)) game.result = tagResult;
+
+    while (m_pos < m_text.size()) {
+        skipSpaceAndComments();
+        if (m_pos >= m_text.size()) break;
+
+        char c = m_text[m_pos];
+        if (c == '[') break;  // next game's tags, this one had no result
+        if (c == '(') {
+            skipVariation();
+            continue;
+        }
+
+        std::string_view token = readToken();
+        if (isResult(token)) {
+            game.result = std::string(token);
+            break;
+        }
+        if (token.front() == '$' || token == ")" || token == "}") continue;
+
+        // Move numbers, "12." or "12...", possibly glued to the move
+        std::size_t digits = 0;
+        while (digits < token.size() && std::isdigit(static_cast<unsigned char>(token[digits]))) ++digits;
+        if (digits < token.size() && token[digits] == '.') {
+            token.remove_prefix(digits);
+            while (!token.empty() && token.front() == '.') token.remove_prefix(1);
+        }
+        if (token.empty() || !game.valid) continue;
+
+        Move move;
+        if (Pgn::parseSan(m_logic, token, move) && m_logic.makeMove(move)) {
+            game.moves.push_back(move);
+        } else {
+            game.valid = false;
+            game.error = "illegal move " + std::string(token) + " at ply " + std::to_string(game.moves.size() + 1);
+        }
+    }
+    return true;
+}
+
+} // namespace Chess
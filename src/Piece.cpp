@@ -2,21 +2,11 @@
 
 namespace Chess {
 
-Piece::Piece() 
-    : m_type(PieceType::None)
-    , m_color(Color::None)
-    , m_hasMoved(false) {
-}
-
-Piece::Piece(PieceType type, Color color)
-    : m_type(type)
-    , m_color(color)
-    , m_hasMoved(false) {
-}
-
 char32_t Piece::getUnicodeChar() const {
-    if (m_color == Color::White) {
-        switch (m_type) {
+    Color color = getColor();
+    PieceType type = getType();
+    if (color == Color::White) {
+        switch (type) {
             case PieceType::King:   return U'\u2654'; // ♔
             case PieceType::Queen:  return U'\u2655'; // ♕
             case PieceType::Rook:   return U'\u2656'; // ♖
@@ -25,8 +15,8 @@ char32_t Piece::getUnicodeChar() const {
             case PieceType::Pawn:   return U'\u2659'; // ♙
             default: return U' ';
         }
-    } else if (m_color == Color::Black) {
-        switch (m_type) {
+    } else if (color == Color::Black) {
+        switch (type) {
             case PieceType::King:   return U'\u265A'; // ♚
             case PieceType::Queen:  return U'\u265B'; // ♛
             case PieceType::Rook:   return U'\u265C'; // ♜
@@ -40,7 +30,7 @@ char32_t Piece::getUnicodeChar() const {
 }
 
 int Piece::getValue() const {
-    switch (m_type) {
+    switch (getType()) {
         case PieceType::Pawn:   return 100;
         case PieceType::Knight: return 320;
         case PieceType::Bishop: return 330;
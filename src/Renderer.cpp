@@ -1,4 +1,5 @@
 #include "Renderer.hpp"
+#include <chrono>
 #include <cmath>
 #include <iostream>
 
@@ -7,6 +8,7 @@ namespace Chess {
 Renderer::Renderer(sf::RenderWindow& window, const Board& board)
     : m_window(window)
     , m_board(board)
+    , m_pieceVertices(sf::PrimitiveType::Triangles)
     , m_tileSize(90.0f)
     , m_boardOffset(40.0f, 40.0f)
     , m_isAnimating(false)
@@ -22,7 +24,7 @@ Renderer::Renderer(sf::RenderWindow& window, const Board& board)
     m_checkColor = sf::Color(255, 0, 0, 150);     // Red for check
 }
 
-bool Renderer::loadResources() {
+void Renderer::startLoading() {
     // Try to load a system font that supports chess pieces
     std::vector<std::string> fontPaths = {
         "/System/Library/Fonts/Supplemental/Arial Unicode.ttf",
@@ -32,68 +34,146 @@ bool Renderer::loadResources() {
         "/System/Library/Fonts/SFNS.ttf"
     };
     
+    // Every candidate is opened at the same time instead of one after another
+    m_fontLoading.clear();
     for (const auto& path : fontPaths) {
-        sf::Font font;
-        if (font.openFromFile(path)) {
-            m_font = std::move(font);
-            return true;
+        m_fontLoading.push_back(std::async(std::launch::async, [path]() -> std::optional<sf::Font> {
+            sf::Font font;
+            if (font.openFromFile(path)) {
+                return font;
+            }
+            return std::nullopt;
+        }));
+    }
+}
+
+bool Renderer::finishLoading() {
+    // The first candidate that opens wins; the slower ones are left running in
+    // m_fontLoading (a std::async future blocks in its destructor) and are never waited for
+    while (!m_font && !m_fontLoading.empty()) {
+        for (auto it = m_fontLoading.begin(); it != m_fontLoading.end();) {
+            if (it->wait_for(std::chrono::milliseconds(1)) != std::future_status::ready) {
+                ++it;
+                continue;
+            }
+            std::optional<sf::Font> font = it->get();
+            it = m_fontLoading.erase(it);
+            if (font) {
+                m_font = std::move(font);
+                break;
+            }
         }
     }
     
-    std::cerr << "Warning: Could not load font. Text may not display correctly." << std::endl;
-    return false;
+    if (!m_font) {
+        std::cerr << "Warning: Could not load font. Text may not display correctly." << std::endl;
+    }
+    buildStaticLayers();
+    return m_font.has_value();
+}
+
+void Renderer::buildStaticLayers() {
+    // Everything under the highlights is static: render it once into a window-sized texture
+    m_boardLayer.emplace();
+    if (m_boardLayer->resize(m_window.getSize())) {
+        m_boardLayer->clear();
+        drawBoardFrame(*m_boardLayer);
+        drawBoard(*m_boardLayer);
+        drawCoordinates(*m_boardLayer);
+        m_boardLayer->display();
+    } else {
+        m_boardLayer.reset();
+    }
+    
+    // One tile per piece: columns follow the piece type, rows the colour
+    m_pieceAtlas.reset();
+    if (!m_font) return;
+    
+    unsigned int tile = static_cast<unsigned int>(std::ceil(m_tileSize));
+    m_pieceAtlas.emplace();
+    if (!m_pieceAtlas->resize(sf::Vector2u(6 * tile, 2 * tile))) {
+        m_pieceAtlas.reset();
+        return;
+    }
+    m_pieceAtlas->clear(sf::Color::Transparent);
+    for (Color color : {Color::White, Color::Black}) {
+        for (PieceType type : {PieceType::Pawn, PieceType::Knight, PieceType::Bishop,
+                               PieceType::Rook, PieceType::Queen, PieceType::King}) {
+            drawPiece(*m_pieceAtlas, Piece(type, color),
+                      static_cast<float>((typeIndex(type) - 1) * tile),
+                      static_cast<float>(colorIndex(color) * tile));
+        }
+    }
+    m_pieceAtlas->display();
 }
 
 void Renderer::render(const Position* selectedPos, 
                       const std::vector<Move>* legalMoves,
                       GameState gameState,
                       Color currentTurn) {
+    // Background, board and coordinates come pre-rendered in a single sprite
+    if (m_boardLayer) {
+        m_window.draw(sf::Sprite(m_boardLayer->getTexture()));
+    } else {
+        drawBoardFrame(m_window);
+        drawBoard(m_window);
+        drawCoordinates(m_window);
+    }
+    
+    drawHighlights(selectedPos, legalMoves);
+    drawPieces(selectedPos);
+    drawGameState(gameState, currentTurn);
+    
+    // Draw game over overlay for checkmate, stalemate and other draws
+    if (gameState == GameState::Checkmate || gameState == GameState::Stalemate || gameState == GameState::Draw) {
+        drawGameOverOverlay(gameState, currentTurn);
+    }
+}
+
+void Renderer::drawBoardFrame(sf::RenderTarget& target) {
     // Draw gradient background
-    sf::RectangleShape background(sf::Vector2f(static_cast<float>(m_window.getSize().x), 
-                                                static_cast<float>(m_window.getSize().y)));
+    sf::RectangleShape background(sf::Vector2f(static_cast<float>(target.getSize().x), 
+                                                static_cast<float>(target.getSize().y)));
     background.setFillColor(sf::Color(40, 44, 52));
-    m_window.draw(background);
+    target.draw(background);
     
     // Draw board shadow
     sf::RectangleShape shadow(sf::Vector2f(m_tileSize * 8 + 10, m_tileSize * 8 + 10));
     shadow.setPosition(sf::Vector2f(m_boardOffset.x + 5, m_boardOffset.y + 5));
     shadow.setFillColor(sf::Color(0, 0, 0, 100));
-    m_window.draw(shadow);
+    target.draw(shadow);
     
     // Draw board border
     sf::RectangleShape border(sf::Vector2f(m_tileSize * 8 + 8, m_tileSize * 8 + 8));
     border.setPosition(sf::Vector2f(m_boardOffset.x - 4, m_boardOffset.y - 4));
     border.setFillColor(sf::Color(60, 60, 50));
-    m_window.draw(border);
-    
-    drawBoard();
-    drawHighlights(selectedPos, legalMoves);
-    drawPieces(selectedPos);
-    drawCoordinates();
-    drawGameState(gameState, currentTurn);
-    
-    // Draw game over overlay for checkmate and stalemate
-    if (gameState == GameState::Checkmate || gameState == GameState::Stalemate) {
-        drawGameOverOverlay(gameState, currentTurn);
-    }
+    target.draw(border);
 }
 
-void Renderer::drawBoard() {
+void Renderer::drawBoard(sf::RenderTarget& target) {
+    // All 64 tiles as two triangles each, in one draw call
+    sf::VertexArray tiles(sf::PrimitiveType::Triangles, 64 * 6);
     for (int row = 0; row < 8; ++row) {
         for (int col = 0; col < 8; ++col) {
-            sf::RectangleShape tile(sf::Vector2f(m_tileSize, m_tileSize));
-            tile.setPosition(sf::Vector2f(m_boardOffset.x + col * m_tileSize, 
-                                          m_boardOffset.y + row * m_tileSize));
+            float left = m_boardOffset.x + col * m_tileSize;
+            float top = m_boardOffset.y + row * m_tileSize;
+            sf::Vector2f corners[6] = {
+                {left, top}, {left + m_tileSize, top}, {left, top + m_tileSize},
+                {left, top + m_tileSize}, {left + m_tileSize, top}, {left + m_tileSize, top + m_tileSize}
+            };
             
             bool isLight = (row + col) % 2 == 0;
-            tile.setFillColor(isLight ? m_lightColor : m_darkColor);
-            
-            m_window.draw(tile);
+            std::size_t first = static_cast<std::size_t>(row * 8 + col) * 6;
+            for (std::size_t i = 0; i < 6; ++i) {
+                tiles[first + i].position = corners[i];
+                tiles[first + i].color = isLight ? m_lightColor : m_darkColor;
+            }
         }
     }
+    target.draw(tiles);
 }
 
-void Renderer::drawCoordinates() {
+void Renderer::drawCoordinates(sf::RenderTarget& target) {
     if (!m_font) return;
     
     unsigned int fontSize = 14;
@@ -104,32 +184,42 @@ void Renderer::drawCoordinates() {
         rowText.setFillColor(sf::Color(200, 200, 200));
         rowText.setPosition(sf::Vector2f(m_boardOffset.x - 20, 
                            m_boardOffset.y + i * m_tileSize + m_tileSize / 2 - fontSize / 2));
-        m_window.draw(rowText);
+        target.draw(rowText);
         
         // Also on right side
         sf::Text rowText2(*m_font, std::to_string(8 - i), fontSize);
         rowText2.setFillColor(sf::Color(200, 200, 200));
         rowText2.setPosition(sf::Vector2f(m_boardOffset.x + 8 * m_tileSize + 8,
                            m_boardOffset.y + i * m_tileSize + m_tileSize / 2 - fontSize / 2));
-        m_window.draw(rowText2);
+        target.draw(rowText2);
         
         // Column letters (a-h)
         sf::Text colText(*m_font, std::string(1, 'a' + i), fontSize);
         colText.setFillColor(sf::Color(200, 200, 200));
         colText.setPosition(sf::Vector2f(m_boardOffset.x + i * m_tileSize + m_tileSize / 2 - fontSize / 3,
                            m_boardOffset.y + 8 * m_tileSize + 5));
-        m_window.draw(colText);
+        target.draw(colText);
         
         // Also on top
         sf::Text colText2(*m_font, std::string(1, 'a' + i), fontSize);
         colText2.setFillColor(sf::Color(200, 200, 200));
         colText2.setPosition(sf::Vector2f(m_boardOffset.x + i * m_tileSize + m_tileSize / 2 - fontSize / 3,
                            m_boardOffset.y - 22));
-        m_window.draw(colText2);
+        target.draw(colText2);
     }
 }
 
 void Renderer::drawPieces(const Position* selectedPos) {
+    // With the atlas, pieces are queued and drawn together at the end
+    m_pieceVertices.clear();
+    auto place = [this](const Piece& piece, float x, float y, float alpha) {
+        if (m_pieceAtlas) {
+            appendPiece(piece, x, y, alpha);
+        } else {
+            drawPiece(m_window, piece, x, y, alpha);
+        }
+    };
+    
     for (int row = 0; row < 8; ++row) {
         for (int col = 0; col < 8; ++col) {
             const Piece& piece = m_board.getPiece(row, col);
@@ -148,7 +238,7 @@ void Renderer::drawPieces(const Position* selectedPos) {
                 alpha = 0.5f; // Semi-transparent for selected piece
             }
             
-            drawPiece(piece, x, y, alpha);
+            place(piece, x, y, alpha);
         }
     }
     
@@ -168,12 +258,36 @@ void Renderer::drawPieces(const Position* selectedPos) {
             float x = startX + (endX - startX) * t;
             float y = startY + (endY - startY) * t;
             
-            drawPiece(piece, x, y);
+            place(piece, x, y, 1.0f);
         }
     }
+    
+    if (m_pieceAtlas && m_pieceVertices.getVertexCount() > 0) {
+        // The atlas holds premultiplied colours (glyphs were blended over transparency)
+        sf::RenderStates states;
+        states.texture = &m_pieceAtlas->getTexture();
+        states.blendMode = sf::BlendMode(sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha);
+        m_window.draw(m_pieceVertices, states);
+    }
 }
 
-void Renderer::drawPiece(const Piece& piece, float x, float y, float alpha) {
+void Renderer::appendPiece(const Piece& piece, float x, float y, float alpha) {
+    float tile = std::ceil(m_tileSize);
+    float u = (typeIndex(piece.getType()) - 1) * tile;
+    float v = colorIndex(piece.getColor()) * tile;
+    
+    // Premultiplied fade: scale every channel, not only alpha
+    std::uint8_t fade = static_cast<std::uint8_t>(255 * alpha);
+    sf::Color tint(fade, fade, fade, fade);
+    
+    sf::Vector2f corners[6] = {{0, 0}, {tile, 0}, {0, tile}, {0, tile}, {tile, 0}, {tile, tile}};
+    for (const sf::Vector2f& corner : corners) {
+        m_pieceVertices.append(sf::Vertex{sf::Vector2f(x + corner.x, y + corner.y), tint,
+                                          sf::Vector2f(u + corner.x, v + corner.y)});
+    }
+}
+
+void Renderer::drawPiece(sf::RenderTarget& target, const Piece& piece, float x, float y, float alpha) {
     if (!m_font) return;
     
     sf::String sfStr = getPieceString(piece);
@@ -199,7 +313,7 @@ void Renderer::drawPiece(const Piece& piece, float x, float y, float alpha) {
     float offsetY = (m_tileSize - bounds.size.y) / 2 - bounds.position.y - m_tileSize * 0.08f;
     
     shadowText.setPosition(sf::Vector2f(x + offsetX + 2, y + offsetY + 2));
-    m_window.draw(shadowText);
+    target.draw(shadowText);
     
     pieceText.setFillColor(pieceColor);
     pieceText.setPosition(sf::Vector2f(x + offsetX, y + offsetY));
@@ -210,7 +324,7 @@ void Renderer::drawPiece(const Piece& piece, float x, float y, float alpha) {
         pieceText.setOutlineThickness(1.0f);
     }
     
-    m_window.draw(pieceText);
+    target.draw(pieceText);
 }
 
 void Renderer::drawHighlights(const Position* selectedPos, 
@@ -392,7 +506,7 @@ void Renderer::drawGameState(GameState state, Color currentTurn) {
     helpBg.setFillColor(sf::Color(30, 34, 42, 200));
     m_window.draw(helpBg);
     
-    sf::Text helpText(*m_font, "R = Nouvelle partie | ESC = Quitter", 13);
+    sf::Text helpText(*m_font, "R = Nouvelle partie | P = Reflexion | ESC = Quitter", 13);
     helpText.setFillColor(sf::Color(140, 140, 140));
     sf::FloatRect helpBounds = helpText.getLocalBounds();
     helpText.setPosition(sf::Vector2f(m_boardOffset.x + (8 * m_tileSize - helpBounds.size.x) / 2, helpY + 10));
@@ -482,6 +596,10 @@ void Renderer::drawGameOverOverlay(GameState state, Color currentTurn) {
         title = "PAT !";
         subtitle = "Match nul - Aucun coup legal possible";
         icon += U'♔';
+    } else if (state == GameState::Draw) {
+        title = "NULLE !";
+        subtitle = "Repetition de la position ou regle des 50 coups";
+        icon += U'♔';
     }
     
     sf::Text titleText(*m_font, title, 28);
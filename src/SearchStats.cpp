@@ -0,0 +1,52 @@
+#include "SearchStats.hpp"
+#include <iomanip>
+
+namespace Chess {
+
+double SearchStats::branchingFactor() const {
+    if (iterations.size() < 2) return 0.0;
+
+    const IterationStats& last = iterations[iterations.size() - 1];
+    const IterationStats& previous = iterations[iterations.size() - 2];
+    std::uint64_t lastNodes = last.nodes - previous.nodes;
+    std::uint64_t previousNodes = previous.nodes - (iterations.size() > 2 ? iterations[iterations.size() - 3].nodes : 0);
+    return previousNodes ? static_cast<double>(lastNodes) / previousNodes : 0.0;
+}
+
+std::ostream& operator<<(std::ostream& out, const SearchStats& stats) {
+    if (stats.bookMove || stats.tablebaseMove) {
+        out << (stats.bookMove ? "book" : "tablebase") << " pv";
+        for (const Move& move : stats.pv) {
+            out << ' ' << move.toUci();
+        }
+        return out;
+    }
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "depth " << stats.depth
+        << " score " << stats.score
+        << " nodes " << stats.nodes
+        << " qnodes " << stats.qnodes
+        << " time " << stats.elapsedMs << "ms"
+        << " nps " << stats.nps()
+        << " threads " << stats.threads
+        << std::fixed << std::setprecision(1)
+        << " cutoffs " << stats.cutoffs
+        << " (first " << 100.0 * stats.firstMoveCutoffRate() << "%)"
+        << " tt " << 100.0 * stats.ttHitRate() << "%"
+        << " tbhits " << stats.tbHits
+        << std::setprecision(2)
+        << " ebf " << stats.branchingFactor()
+        << " pv";
+    for (const Move& move : stats.pv) {
+        out << ' ' << move.toUci();
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+    return out;
+}
+
+} // namespace Chess
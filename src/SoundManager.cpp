@@ -1,50 +1,69 @@
 #include "SoundManager.hpp"
 #include <cmath>
-#include <cstdlib>
+#include <chrono>
 
 namespace Chess {
 
-SoundManager::SoundManager() : m_volume(50.0f) {
-    std::vector<std::int16_t> samples;
-    std::vector<sf::SoundChannel> channelMap = {sf::SoundChannel::Mono};
+SoundManager::SoundManager()
+    : m_pending(std::async(std::launch::async, &SoundManager::synthesize))
+    , m_ready(false)
+    , m_volume(50.0f) {
+}
+
+SoundManager::Samples SoundManager::synthesize() {
+    Samples samples;
     
     // Generate move sound (soft click)
-    samples.clear();
-    generateTone(samples, 800, 0.05f, 0.3f);
-    generateTone(samples, 600, 0.03f, 0.2f);
-    (void)m_moveBuffer.loadFromSamples(samples.data(), samples.size(), 1, SAMPLE_RATE, channelMap);
+    generateTone(samples.move, 800, 0.05f, 0.3f);
+    generateTone(samples.move, 600, 0.03f, 0.2f);
     
     // Generate capture sound (stronger impact)
-    samples.clear();
-    generateTone(samples, 300, 0.08f, 0.5f);
-    generateTone(samples, 200, 0.1f, 0.4f);
-    generateTone(samples, 150, 0.05f, 0.2f);
-    (void)m_captureBuffer.loadFromSamples(samples.data(), samples.size(), 1, SAMPLE_RATE, channelMap);
+    generateTone(samples.capture, 300, 0.08f, 0.5f);
+    generateTone(samples.capture, 200, 0.1f, 0.4f);
+    generateTone(samples.capture, 150, 0.05f, 0.2f);
     
     // Generate check sound (alert)
-    samples.clear();
-    generateTone(samples, 880, 0.1f, 0.4f);
-    generateTone(samples, 1100, 0.1f, 0.5f);
-    generateTone(samples, 880, 0.15f, 0.3f);
-    (void)m_checkBuffer.loadFromSamples(samples.data(), samples.size(), 1, SAMPLE_RATE, channelMap);
+    generateTone(samples.check, 880, 0.1f, 0.4f);
+    generateTone(samples.check, 1100, 0.1f, 0.5f);
+    generateTone(samples.check, 880, 0.15f, 0.3f);
     
     // Generate game over sound (fanfare)
-    samples.clear();
-    generateTone(samples, 523, 0.15f, 0.4f);  // C
-    generateTone(samples, 659, 0.15f, 0.4f);  // E
-    generateTone(samples, 784, 0.15f, 0.4f);  // G
-    generateTone(samples, 1047, 0.3f, 0.5f);  // C (octave)
-    (void)m_gameOverBuffer.loadFromSamples(samples.data(), samples.size(), 1, SAMPLE_RATE, channelMap);
+    generateTone(samples.gameOver, 523, 0.15f, 0.4f);  // C
+    generateTone(samples.gameOver, 659, 0.15f, 0.4f);  // E
+    generateTone(samples.gameOver, 784, 0.15f, 0.4f);  // G
+    generateTone(samples.gameOver, 1047, 0.3f, 0.5f);  // C (octave)
     
     // Generate menu click sound
-    samples.clear();
-    generateClick(samples);
-    (void)m_menuClickBuffer.loadFromSamples(samples.data(), samples.size(), 1, SAMPLE_RATE, channelMap);
+    std::minstd_rand noise(std::random_device{}());
+    generateClick(samples.menuClick, noise);
     
     // Generate menu hover sound (soft blip)
-    samples.clear();
-    generateTone(samples, 1200, 0.03f, 0.15f);
-    (void)m_menuHoverBuffer.loadFromSamples(samples.data(), samples.size(), 1, SAMPLE_RATE, channelMap);
+    generateTone(samples.menuHover, 1200, 0.03f, 0.15f);
+    
+    return samples;
+}
+
+bool SoundManager::isReady() {
+    if (m_ready) return true;
+    if (!m_pending.valid() ||
+        m_pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+    
+    // Buffers are created here, on the thread that plays them
+    Samples samples = m_pending.get();
+    std::vector<sf::SoundChannel> channelMap = {sf::SoundChannel::Mono};
+    auto attach = [&channelMap](sf::SoundBuffer& buffer, const std::vector<std::int16_t>& data) {
+        (void)buffer.loadFromSamples(data.data(), data.size(), 1, SAMPLE_RATE, channelMap);
+    };
+    attach(m_moveBuffer, samples.move);
+    attach(m_captureBuffer, samples.capture);
+    attach(m_checkBuffer, samples.check);
+    attach(m_gameOverBuffer, samples.gameOver);
+    attach(m_menuClickBuffer, samples.menuClick);
+    attach(m_menuHoverBuffer, samples.menuHover);
+    m_ready = true;
+    return true;
 }
 
 void SoundManager::generateTone(std::vector<std::int16_t>& samples, float frequency, float duration, float volume) {
@@ -72,9 +91,10 @@ void SoundManager::generateTone(std::vector<std::int16_t>& samples, float freque
     }
 }
 
-void SoundManager::generateClick(std::vector<std::int16_t>& samples) {
+void SoundManager::generateClick(std::vector<std::int16_t>& samples, std::minstd_rand& noise) {
     size_t numSamples = static_cast<size_t>(SAMPLE_RATE * 0.05f);
     samples.resize(numSamples);
+    std::uniform_real_distribution<float> white(-1.0f, 1.0f);
     
     for (size_t i = 0; i < numSamples; ++i) {
         float t = static_cast<float>(i) / SAMPLE_RATE;
@@ -84,45 +104,40 @@ void SoundManager::generateClick(std::vector<std::int16_t>& samples) {
         float sample = 0;
         sample += std::sin(2.0f * 3.14159f * 1500 * t) * 0.3f;
         sample += std::sin(2.0f * 3.14159f * 2500 * t) * 0.2f;
-        sample += (static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f) * 0.3f; // Noise
+        sample += white(noise) * 0.3f; // Noise
         
         samples[i] = static_cast<std::int16_t>(sample * envelope * 32767 * 0.4f);
     }
 }
 
 void SoundManager::playMove() {
-    m_sound = std::make_unique<sf::Sound>(m_moveBuffer);
-    m_sound->setVolume(m_volume);
-    m_sound->play();
+    play(m_moveBuffer, m_volume);
 }
 
 void SoundManager::playCapture() {
-    m_sound = std::make_unique<sf::Sound>(m_captureBuffer);
-    m_sound->setVolume(m_volume);
-    m_sound->play();
+    play(m_captureBuffer, m_volume);
 }
 
 void SoundManager::playCheck() {
-    m_sound = std::make_unique<sf::Sound>(m_checkBuffer);
-    m_sound->setVolume(m_volume);
-    m_sound->play();
+    play(m_checkBuffer, m_volume);
 }
 
 void SoundManager::playGameOver() {
-    m_sound = std::make_unique<sf::Sound>(m_gameOverBuffer);
-    m_sound->setVolume(m_volume);
-    m_sound->play();
+    play(m_gameOverBuffer, m_volume);
 }
 
 void SoundManager::playMenuClick() {
-    m_sound = std::make_unique<sf::Sound>(m_menuClickBuffer);
-    m_sound->setVolume(m_volume);
-    m_sound->play();
+    play(m_menuClickBuffer, m_volume);
 }
 
 void SoundManager::playMenuHover() {
-    m_sound = std::make_unique<sf::Sound>(m_menuHoverBuffer);
-    m_sound->setVolume(m_volume * 0.5f);
+    play(m_menuHoverBuffer, m_volume * 0.5f);
+}
+
+void SoundManager::play(const sf::SoundBuffer& buffer, float volume) {
+    if (!isReady()) return;
+    m_sound = std::make_unique<sf::Sound>(buffer);
+    m_sound->setVolume(volume);
     m_sound->play();
 }
 
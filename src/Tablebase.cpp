@@ -0,0 +1,139 @@
+#include "Tablebase.hpp"
+#include <algorithm>
+#include <mutex>
+
+#ifdef CHESS_USE_FATHOM
+extern "C" {
+#include "tbprobe.h"
+}
+#endif
+
+namespace Chess {
+
+namespace Tablebase {
+
+#ifdef CHESS_USE_FATHOM
+
+namespace {
+
+// Position au format de Fathom : cases numérotées depuis a1, donc rangées inversées
+struct FathomPosition {
+    std::uint64_t white;
+    std::uint64_t black;
+    std::uint64_t kings;
+    std::uint64_t queens;
+    std::uint64_t rooks;
+    std::uint64_t bishops;
+    std::uint64_t knights;
+    std::uint64_t pawns;
+    unsigned enPassant;
+    bool whiteToMove;
+};
+
+std::uint64_t toFathom(Bitboard bitboard) { return __builtin_bswap64(bitboard); }
+int toFathomSquare(int sq) { return (7 - (sq >> 3)) * 8 + (sq & 7); }
+int fromFathomSquare(int sq) { return (7 - (sq >> 3)) * 8 + (sq & 7); }
+
+// tb_probe_root garde son état dans des globales de Fathom : plusieurs AIPlayer
+// (EnginePool, selfplay) le sérialisent ici
+std::mutex rootProbeMutex;
+
+Bitboard bothColors(const Board& board, PieceType type) {
+    return board.getPieces(Color::White, type) | board.getPieces(Color::Black, type);
+}
+
+FathomPosition fathomPosition(const Board& board) {
+    Position enPassant = board.getEnPassantTarget();
+    return {
+        toFathom(board.getPieces(Color::White)),
+        toFathom(board.getPieces(Color::Black)),
+        toFathom(bothColors(board, PieceType::King)),
+        toFathom(bothColors(board, PieceType::Queen)),
+        toFathom(bothColors(board, PieceType::Rook)),
+        toFathom(bothColors(board, PieceType::Bishop)),
+        toFathom(bothColors(board, PieceType::Knight)),
+        toFathom(bothColors(board, PieceType::Pawn)),
+        enPassant.isValid() ? static_cast<unsigned>(toFathomSquare(squareIndex(enPassant))) : 0u,
+        board.getSideToMove() == Color::White
+    };
+}
+
+} // namespace
+
+bool init(const std::string& path) {
+    return tb_init(path.c_str()) && TB_LARGEST > 0;
+}
+
+void release() {
+    tb_free();
+}
+
+int maxPieces() {
+    return static_cast<int>(TB_LARGEST);
+}
+
+// Fathom ne sonde les WDL qu'avec un compteur des 50 coups nul : la recherche ne
+// l'appelle que juste après une prise ou un coup de pion
+bool probeWdl(const Board& board, Wdl& result) {
+    FathomPosition pos = fathomPosition(board);
+    unsigned wdl = tb_probe_wdl(pos.white, pos.black, pos.kings, pos.queens, pos.rooks,
+                                pos.bishops, pos.knights, pos.pawns, 0, 0, pos.enPassant, pos.whiteToMove);
+    if (wdl == TB_RESULT_FAILED) {
+        return false;
+    }
+    result = static_cast<Wdl>(wdl);
+    return true;
+}
+
+bool probeRoot(const Board& board, int halfmoveClock, PackedMove& move, Wdl& result) {
+    FathomPosition pos = fathomPosition(board);
+    std::lock_guard<std::mutex> lock(rootProbeMutex);
+    unsigned root = tb_probe_root(pos.white, pos.black, pos.kings, pos.queens, pos.rooks,
+                                  pos.bishops, pos.knights, pos.pawns,
+                                  static_cast<unsigned>(halfmoveClock), 0, pos.enPassant,
+                                  pos.whiteToMove, nullptr);
+    if (root == TB_RESULT_FAILED || root == TB_RESULT_CHECKMATE || root == TB_RESULT_STALEMATE) {
+        return false;
+    }
+
+    int from = fromFathomSquare(TB_GET_FROM(root));
+    int to = fromFathomSquare(TB_GET_TO(root));
+    int flags = PackedMove::Quiet;
+    switch (TB_GET_PROMOTES(root)) {
+        case TB_PROMOTES_QUEEN:  flags = PackedMove::Promotion | 3; break;
+        case TB_PROMOTES_ROOK:   flags = PackedMove::Promotion | 2; break;
+        case TB_PROMOTES_BISHOP: flags = PackedMove::Promotion | 1; break;
+        case TB_PROMOTES_KNIGHT: flags = PackedMove::Promotion; break;
+        default: break;
+    }
+    move = PackedMove(from, to, flags);
+    result = static_cast<Wdl>(TB_GET_WDL(root));
+    return true;
+}
+
+#else
+
+bool init(const std::string&) { return false; }
+void release() {}
+int maxPieces() { return 0; }
+bool probeWdl(const Board&, Wdl&) { return false; }
+bool probeRoot(const Board&, int, PackedMove&, Wdl&) { return false; }
+
+#endif
+
+bool canProbe(const Board& board, int pieceLimit) {
+    if (popCount(board.getOccupied()) > std::min(pieceLimit, maxPieces())) {
+        return false;
+    }
+    // Les tables ignorent le roque
+    for (Color color : {Color::White, Color::Black}) {
+        if (board.canCastleKingside(color) || board.canCastleQueenside(color)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Tablebase
+
+} // namespace Chess
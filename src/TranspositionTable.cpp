@@ -0,0 +1,88 @@
+#include "TranspositionTable.hpp"
+
+namespace Chess {
+
+TranspositionTable::TranspositionTable(std::size_t megabytes)
+    : m_count(0)
+    , m_mask(0)
+    , m_sizeMB(0) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(std::size_t megabytes) {
+    if (megabytes == 0) megabytes = 1;
+
+    // Nombre de cases arrondi à la puissance de deux inférieure (index = clé & masque)
+    std::size_t count = (megabytes * 1024 * 1024) / sizeof(Slot);
+    std::size_t slots = 1;
+    while (slots * 2 <= count) slots *= 2;
+
+    m_slots = std::make_unique<Slot[]>(slots);
+    m_count = slots;
+    m_mask = slots - 1;
+    m_sizeMB = megabytes;
+}
+
+void TranspositionTable::clear() {
+    for (std::size_t i = 0; i < m_count; ++i) {
+        m_slots[i].keyXorData.store(0, std::memory_order_relaxed);
+        m_slots[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+// score (32 bits) | profondeur (8) | borne (8) | coup (16)
+std::uint64_t TranspositionTable::pack(const TTEntry& entry) {
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(entry.score))
+         | (static_cast<std::uint64_t>(static_cast<std::uint8_t>(entry.depth)) << 32)
+         | (static_cast<std::uint64_t>(entry.bound) << 40)
+         | (static_cast<std::uint64_t>(entry.move.raw()) << 48);
+}
+
+TTEntry TranspositionTable::unpack(std::uint64_t key, std::uint64_t data) {
+    TTEntry entry;
+    entry.key = key;
+    entry.score = static_cast<std::int32_t>(static_cast<std::uint32_t>(data));
+    entry.depth = static_cast<std::int8_t>(static_cast<std::uint8_t>(data >> 32));
+    entry.bound = static_cast<Bound>(static_cast<std::uint8_t>(data >> 40));
+    entry.move = PackedMove::fromRaw(static_cast<std::uint16_t>(data >> 48));
+    return entry;
+}
+
+bool TranspositionTable::probe(std::uint64_t key, TTEntry& entry) const {
+    const Slot& slot = m_slots[key & m_mask];
+    std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+    std::uint64_t keyXorData = slot.keyXorData.load(std::memory_order_relaxed);
+    if ((keyXorData ^ data) != key) {
+        return false;
+    }
+    entry = unpack(key, data);
+    return entry.bound != Bound::None;
+}
+
+void TranspositionTable::store(std::uint64_t key, int depth, Bound bound, int score, PackedMove bestMove) {
+    Slot& slot = m_slots[key & m_mask];
+    std::uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+    bool sameKey = (slot.keyXorData.load(std::memory_order_relaxed) ^ oldData) == key;
+    TTEntry old = unpack(key, oldData);
+
+    // Remplacement : autre position, ou recherche au moins aussi profonde
+    if (sameKey && depth < old.depth && bound != Bound::Exact) {
+        return;
+    }
+
+    TTEntry entry;
+    entry.score = score;
+    entry.depth = static_cast<std::int8_t>(depth);
+    entry.bound = bound;
+    entry.move = bestMove;
+    // Garder l'ancien meilleur coup si la nouvelle recherche n'en a pas trouvé
+    if (entry.move.isNull() && sameKey) {
+        entry.move = old.move;
+    }
+
+    std::uint64_t data = pack(entry);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.keyXorData.store(key ^ data, std::memory_order_relaxed);
+}
+
+} // namespace Chess
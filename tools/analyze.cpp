@@ -0,0 +1,108 @@
+// Batch analysis of FEN positions on a pool of independent engines.
+//
+//   ./analyze [-j instances] [-d depth] [-t movetime_ms] [-H hash_mb] [file]
+//
+// Reads one FEN per line from the file (or stdin); empty lines and lines
+// starting with '#' are skipped. Every position is searched once and gives one
+// tab-separated line: fen, best move, score (centipawns for the side to move, or
+// "mate N" as in UCI, negative when the side to move is mated), depth, nodes,
+// time in ms and principal variation. A summary with the
+// throughput goes to stderr. By default one engine runs per core, at the
+// Master depth.
+
+#include "EnginePool.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Chess;
+
+namespace {
+
+// Centipawns, or moves to mate like the UCI "score mate"
+std::string formatScore(int score) {
+    if (std::abs(score) > AIPlayer::MATE_SCORE - AIPlayer::MAX_PLY) {
+        int plies = AIPlayer::MATE_SCORE - std::abs(score);
+        int moves = (plies + 1) / 2;
+        return "mate " + std::to_string(score > 0 ? moves : -moves);
+    }
+    return std::to_string(score);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int instances = 0;
+    std::size_t hash = TranspositionTable::DEFAULT_SIZE_MB;
+    AnalysisLimits limits;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "-j" || arg == "-d" || arg == "-t" || arg == "-H") && i + 1 < argc) {
+            int value = std::atoi(argv[++i]);
+            if (arg == "-j") instances = value;
+            else if (arg == "-d") limits.depth = value;
+            else if (arg == "-t") limits.moveTimeMs = value;
+            else hash = static_cast<std::size_t>(std::max(1, value));
+        } else if (arg[0] == '-') {
+            std::cerr << "Usage: " << argv[0] << " [-j instances] [-d depth] [-t movetime_ms] [-H hash_mb] [file]"
+                      << std::endl;
+            return 1;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    std::ifstream file;
+    if (path) {
+        file.open(path);
+        if (!file) {
+            std::cerr << "Cannot read " << path << std::endl;
+            return 1;
+        }
+    }
+    std::istream& in = path ? file : std::cin;
+
+    std::vector<std::string> fens;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        fens.push_back(line);
+    }
+
+    EnginePool pool(instances, hash);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<AnalysisResult> results = pool.analyse(fens, limits);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::uint64_t nodes = 0;
+    int failed = 0;
+    for (const AnalysisResult& result : results) {
+        std::cout << result.fen << '\t';
+        if (!result.valid) {
+            std::cout << "none" << std::endl;
+            ++failed;
+            continue;
+        }
+        std::cout << result.bestMove.toUci() << '\t' << formatScore(result.score) << '\t' << result.depth << '\t'
+                  << result.nodes << '\t' << result.elapsedMs << '\t';
+        for (std::size_t i = 0; i < result.pv.size(); ++i) {
+            std::cout << (i ? " " : "") << result.pv[i].toUci();
+        }
+        std::cout << std::endl;
+        nodes += result.nodes;
+    }
+
+    double seconds = elapsed.count();
+    std::cerr << results.size() << " positions on " << pool.size() << " engines in " << seconds << " s ("
+              << (seconds > 0 ? results.size() / seconds : 0.0) << " positions/s, "
+              << static_cast<std::uint64_t>(seconds > 0 ? nodes / seconds : 0) << " nps)";
+    if (failed) std::cerr << ", " << failed << " without a move";
+    std::cerr << std::endl;
+    return 0;
+}
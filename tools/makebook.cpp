@@ -0,0 +1,143 @@
+// Builds an opening book for AIPlayer from lines of UCI moves or PGN games.
+//
+//   ./makebook <lines.txt | games.pgn> <book.bin> [maxPly]
+//
+// Each non-empty line of a text input is one opening played from the start
+// position ("e2e4 e7e5 g1f3 ..."); text after '#' is a comment. A .pgn input
+// is streamed game by game (games from a custom FEN or with an illegal move
+// are skipped), so large databases can go straight into a book.
+// Every position reached gets the next move, weighted by how many lines play
+// it. Only the first maxPly moves of a line go into the book (default 16).
+// The book uses the engine's own Zobrist keys: it is read by OpeningBook only,
+// not by Polyglot tools, even though the entries share the Polyglot layout.
+
+#include "Board.hpp"
+#include "ChessLogic.hpp"
+#include "OpeningBook.hpp"
+#include "Pgn.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Chess;
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <lines.txt | games.pgn> <book.bin> [maxPly]" << std::endl;
+        return 1;
+    }
+    int maxPly = argc > 3 ? std::atoi(argv[3]) : 16;
+
+    // (position key, raw move) -> number of lines playing it
+    std::map<std::pair<std::uint64_t, std::uint16_t>, unsigned> counts;
+    std::string text;
+    int lineNumber = 0;
+    int lines = 0;
+    bool ok = true;
+
+    std::string input = argv[1];
+    bool pgn = input.size() > 4 && input.compare(input.size() - 4, 4, ".pgn") == 0;
+    if (pgn) {
+        PgnReader reader;
+        if (!reader.open(input)) {
+            std::cerr << "Cannot read " << input << std::endl;
+            return 1;
+        }
+        PgnGame game;
+        int skipped = 0;
+        int gameNumber = 0;
+        while (reader.next(game)) {
+            ++gameNumber;
+            if (!game.valid || !game.tag("FEN").empty()) {
+                ++skipped;
+                continue;
+            }
+            Board board;
+            board.initialize();
+            ChessLogic logic(board);
+            int plies = std::min(maxPly, static_cast<int>(game.moves.size()));
+            bool any = false;
+            for (int ply = 0; ply < plies; ++ply) {
+                // The reader already checked the game: a refused move means both
+                // rule sets disagree, the rest of the game is not imported
+                std::uint64_t key = board.getHash();
+                if (!logic.makeMove(game.moves[ply])) {
+                    std::cerr << argv[1] << ": game " << gameNumber << ", ply " << ply + 1
+                              << ": illegal move " << game.moves[ply].toUci() << std::endl;
+                    ok = false;
+                    break;
+                }
+                ++counts[{key, PackedMove::fromMove(game.moves[ply]).raw()}];
+                any = true;
+            }
+            if (any) ++lines;
+        }
+        if (skipped) std::cerr << skipped << " games skipped" << std::endl;
+    }
+
+    std::ifstream in;
+    if (!pgn) {
+        in.open(input);
+        if (!in) {
+            std::cerr << "Cannot read " << input << std::endl;
+            return 1;
+        }
+    }
+
+    while (!pgn && std::getline(in, text)) {
+        ++lineNumber;
+        text = text.substr(0, text.find('#'));
+        std::istringstream words(text);
+
+        Board board;
+        board.initialize();
+        ChessLogic logic(board);
+        std::string uci;
+        int ply = 0;
+        bool any = false;
+        while (words >> uci && ply < maxPly) {
+            Move chosen{};
+            bool found = false;
+            for (const Move& move : logic.getAllLegalMoves(logic.getCurrentTurn())) {
+                if (move.toUci() == uci) {
+                    chosen = move;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                std::cerr << argv[1] << ':' << lineNumber << ": illegal move " << uci << std::endl;
+                ok = false;
+                break;
+            }
+
+            ++counts[{board.getHash(), PackedMove::fromMove(chosen).raw()}];
+            logic.makeMove(chosen);
+            ++ply;
+            any = true;
+        }
+        if (any) ++lines;
+    }
+
+    std::vector<BookEntry> entries;
+    for (const auto& [key, count] : counts) {
+        BookEntry entry;
+        entry.key = key.first;
+        entry.move = PackedMove::fromRaw(key.second);
+        entry.weight = static_cast<std::uint16_t>(count < 65535 ? count : 65535);
+        entries.push_back(entry);
+    }
+
+    if (!OpeningBook::write(argv[2], entries)) {
+        std::cerr << "Cannot write " << argv[2] << std::endl;
+        return 1;
+    }
+    std::cout << lines << " lines, " << entries.size() << " entries written to " << argv[2] << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+// Headless perft driver: counts the leaf nodes of the move tree with both move
+// generators (ChessLogic for the game, AIPlayer for the search) and compares
+// them with the published reference counts.
+//
+//   ./perft                     run the reference suite
+//   ./perft <depth> [fen]       divide per root move (start position by default)
+
+#include "Board.hpp"
+#include "ChessLogic.hpp"
+#include "AIPlayer.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Chess;
+
+namespace {
+
+const char* START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+struct ReferencePosition {
+    const char* name;
+    const char* fen;
+    std::vector<std::uint64_t> nodes;  // expected counts at depth 1, 2, ...
+    int suiteDepth;                    // depth run by the default suite
+};
+
+// Standard positions from the Chess Programming Wiki perft results page
+const std::vector<ReferencePosition> REFERENCE_POSITIONS = {
+    {"start", START_FEN,
+     {20, 400, 8902, 197281, 4865609}, 4},
+    {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+     {48, 2039, 97862, 4085603}, 3},
+    {"position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+     {14, 191, 2812, 43238, 674624}, 4},
+    {"position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+     {6, 264, 9467, 422333}, 3},
+    {"position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+     {44, 1486, 62379, 2103487}, 3},
+    {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+     {46, 2079, 89890, 3894594}, 3},
+};
+
+struct Result {
+    std::uint64_t nodes;
+    double seconds;
+};
+
+Result timed(const std::function<std::uint64_t()>& count) {
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t nodes = count();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return {nodes, elapsed.count()};
+}
+
+std::string formatNps(const Result& result) {
+    std::ostringstream out;
+    double nps = result.seconds > 0.0 ? result.nodes / result.seconds : 0.0;
+    out << std::fixed << std::setprecision(2) << nps / 1e6 << " Mnps";
+    return out.str();
+}
+
+int runSuite() {
+    bool allPassed = true;
+
+    for (const ReferencePosition& ref : REFERENCE_POSITIONS) {
+        std::uint64_t expected = ref.nodes[ref.suiteDepth - 1];
+
+        Board board;
+        board.loadFEN(ref.fen);
+        ChessLogic logic(board);
+        AIPlayer ai(board, logic);
+
+        Result logicResult = timed([&] { return logic.perft(ref.suiteDepth); });
+        Board searchBoard = board;
+        Result aiResult = timed([&] { return ai.perft(searchBoard, ref.suiteDepth); });
+
+        bool passed = logicResult.nodes == expected && aiResult.nodes == expected;
+        allPassed = allPassed && passed;
+
+        std::cout << std::left << std::setw(10) << ref.name
+                  << " depth " << ref.suiteDepth
+                  << "  expected " << std::setw(9) << expected
+                  << "  ChessLogic " << std::setw(9) << logicResult.nodes
+                  << " (" << formatNps(logicResult) << ")"
+                  << "  AIPlayer " << std::setw(9) << aiResult.nodes
+                  << " (" << formatNps(aiResult) << ")"
+                  << "  " << (passed ? "OK" : "FAIL") << std::endl;
+    }
+
+    return allPassed ? 0 : 1;
+}
+
+int runDivide(int depth, const std::string& fen) {
+    Board board;
+    if (!board.loadFEN(fen)) {
+        std::cerr << "Invalid FEN: " << fen << std::endl;
+        return 1;
+    }
+    ChessLogic logic(board);
+    AIPlayer ai(board, logic);
+
+    // Divide: subtree size below each root move, for both generators
+    std::uint64_t logicTotal = 0;
+    std::uint64_t aiTotal = 0;
+    for (const Move& move : logic.getAllLegalMoves(logic.getCurrentTurn())) {
+        logic.makeMove(move);
+        std::uint64_t logicNodes = logic.perft(depth - 1);
+        logic.undoMove();
+
+        Board child = board;
+        child.applyMove(move);
+        std::uint64_t aiNodes = ai.perft(child, depth - 1);
+
+        logicTotal += logicNodes;
+        aiTotal += aiNodes;
+        std::cout << move.toUci() << ": " << logicNodes;
+        if (aiNodes != logicNodes) {
+            std::cout << "  (AIPlayer: " << aiNodes << ")";
+        }
+        std::cout << std::endl;
+    }
+
+    Result logicResult = timed([&] { return logic.perft(depth); });
+    Board searchBoard = board;
+    Result aiResult = timed([&] { return ai.perft(searchBoard, depth); });
+
+    std::cout << std::endl
+              << "ChessLogic: " << logicResult.nodes << " nodes in "
+              << logicResult.seconds << " s (" << formatNps(logicResult) << ")" << std::endl
+              << "AIPlayer:   " << aiResult.nodes << " nodes in "
+              << aiResult.seconds << " s (" << formatNps(aiResult) << ")" << std::endl;
+
+    bool consistent = logicTotal == logicResult.nodes && aiTotal == aiResult.nodes &&
+                      logicResult.nodes == aiResult.nodes;
+    if (!consistent) {
+        std::cout << "Generators disagree!" << std::endl;
+    }
+    return consistent ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return runSuite();
+    }
+
+    int depth = std::atoi(argv[1]);
+    if (depth < 1) {
+        std::cerr << "Usage: " << argv[0] << " [<depth> [fen]]" << std::endl;
+        return 1;
+    }
+
+    // The FEN may come as one quoted argument or as its separate fields
+    std::string fen;
+    for (int i = 2; i < argc; ++i) {
+        if (!fen.empty()) fen += ' ';
+        fen += argv[i];
+    }
+    return runDivide(depth, fen.empty() ? START_FEN : fen);
+}
@@ -0,0 +1,406 @@
+// Self-play tournament between two AIPlayer configurations, with an SPRT stop rule.
+//
+//   ./selfplay [-a spec] [-b spec] [-j threads] [-n games] [-o openings]
+//              [-p plies] [-l maxplies] [-e elo0 elo1] [-r alpha beta]
+//
+// A spec is a comma-separated list of settings for one engine, e.g.
+// "depth=6,null=off" or "time=50,level=master,hash=32":
+//   level=easy|medium|hard|expert|master   difficulty (default master)
+//   depth=<n>      depth limit instead of the level's
+//   time=<ms>      fixed time per move
+//   hash=<mb>      transposition table size (default 16)
+//   null|lmr|futility=on|off               selective search features
+//
+// Games are played in pairs on worker threads, one per core by default. Openings
+// come from a file of UCI move lines (default tools/openings.txt, cut after
+// -p plies, default 8) or of FEN lines; each pair plays one opening twice with
+// colours swapped on the same worker, so both engines get the same positions.
+// A pair counts only when both of its games finish: an aborted game drops its
+// partner too, so openings and colours stay balanced. A game ends on
+// checkmate, stalemate, repetition, the 50-move rule, bare material, or as a
+// draw after -l plies (default 400).
+//
+// After every pair the tool updates the score of engine A against engine B and
+// the log-likelihood ratio of the hypotheses "A is elo1 stronger" against "A is
+// elo0 stronger" (default 0 and 5, error rates -r alpha beta, default 0.05).
+// The run stops once the ratio leaves [log(beta/(1-alpha)), log((1-beta)/alpha)]
+// or after -n games (default 1000, rounded down to whole pairs).
+
+#include "Board.hpp"
+#include "ChessLogic.hpp"
+#include "AIPlayer.hpp"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Chess;
+
+namespace {
+
+const char* START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+struct EngineConfig {
+    AIDifficulty difficulty = AIDifficulty::Master;
+    int depth = 0;
+    int moveTimeMs = 0;
+    std::size_t hashMegabytes = TranspositionTable::DEFAULT_SIZE_MB;
+    SearchFeatures features;
+};
+
+bool parseSwitch(const std::string& value, bool& result) {
+    if (value == "on" || value == "1" || value == "true") {
+        result = true;
+    } else if (value == "off" || value == "0" || value == "false") {
+        result = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseConfig(const std::string& spec, EngineConfig& config) {
+    std::istringstream items(spec);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        if (item.empty()) continue;
+        std::size_t equals = item.find('=');
+        if (equals == std::string::npos) return false;
+        std::string key = item.substr(0, equals);
+        std::string value = item.substr(equals + 1);
+
+        if (key == "level") {
+            const char* names[] = {"easy", "medium", "hard", "expert", "master"};
+            bool found = false;
+            for (int i = 0; i < 5; ++i) {
+                if (value == names[i] || value == std::to_string(i + 1)) {
+                    config.difficulty = static_cast<AIDifficulty>(i + 1);
+                    found = true;
+                }
+            }
+            if (!found) return false;
+        } else if (key == "depth") {
+            config.depth = std::atoi(value.c_str());
+        } else if (key == "time") {
+            config.moveTimeMs = std::atoi(value.c_str());
+        } else if (key == "hash") {
+            config.hashMegabytes = static_cast<std::size_t>(std::max(1, std::atoi(value.c_str())));
+        } else if (key == "null") {
+            if (!parseSwitch(value, config.features.nullMove)) return false;
+        } else if (key == "lmr") {
+            if (!parseSwitch(value, config.features.lateMoveReductions)) return false;
+        } else if (key == "futility") {
+            if (!parseSwitch(value, config.features.futility)) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void configure(AIPlayer& ai, const EngineConfig& config) {
+    ai.setDifficulty(config.difficulty);
+    ai.setDepthLimit(config.depth);
+    ai.setMoveTime(config.moveTimeMs);
+    ai.setHashSize(config.hashMegabytes);
+    ai.setSearchFeatures(config.features);
+}
+
+bool playUci(ChessLogic& logic, const std::string& uci) {
+    for (const Move& move : logic.getAllLegalMoves(logic.getCurrentTurn())) {
+        if (move.toUci() == uci) {
+            return logic.makeMove(move);
+        }
+    }
+    return false;
+}
+
+// An opening is a start FEN followed by UCI moves played from it
+struct Opening {
+    std::string fen = START_FEN;
+    std::vector<std::string> moves;
+};
+
+bool loadOpenings(const std::string& path, int plies, std::vector<Opening>& openings) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    std::string text;
+    while (std::getline(in, text)) {
+        text = text.substr(0, text.find('#'));
+        if (text.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        Opening opening;
+        if (text.find('/') != std::string::npos) {
+            opening.fen = text;
+        } else {
+            std::istringstream words(text);
+            std::string uci;
+            while (static_cast<int>(opening.moves.size()) < plies && words >> uci) {
+                opening.moves.push_back(uci);
+            }
+        }
+        openings.push_back(opening);
+    }
+    return true;
+}
+
+// Neither side can checkmate: bare kings, or a single minor piece left
+bool insufficientMaterial(const Board& board) {
+    for (Color color : {Color::White, Color::Black}) {
+        if (board.getPieces(color, PieceType::Pawn) || board.getPieces(color, PieceType::Rook) ||
+            board.getPieces(color, PieceType::Queen)) {
+            return false;
+        }
+    }
+    return popCount(board.getOccupied()) <= 3;
+}
+
+enum class Outcome { WhiteWins, BlackWins, Draw, Aborted };
+
+// Plays one game on its own board, white and black being the two engines
+Outcome playGame(const Opening& opening, AIPlayer& white, AIPlayer& black,
+                 Board& board, ChessLogic& logic, int maxPlies) {
+    if (!logic.loadFEN(opening.fen)) return Outcome::Aborted;
+    for (const std::string& uci : opening.moves) {
+        if (!playUci(logic, uci)) return Outcome::Aborted;
+    }
+    white.clearHash();
+    black.clearHash();
+
+    for (int ply = 0; ply < maxPlies; ++ply) {
+        switch (logic.getGameState()) {
+            case GameState::Checkmate:
+                return logic.getCurrentTurn() == Color::White ? Outcome::BlackWins : Outcome::WhiteWins;
+            case GameState::Stalemate:
+            case GameState::Draw:
+                return Outcome::Draw;
+            default:
+                break;
+        }
+        if (insufficientMaterial(board)) return Outcome::Draw;
+
+        Color side = logic.getCurrentTurn();
+        AIPlayer& ai = side == Color::White ? white : black;
+        // Mate and stalemate are caught above, so the side to move has a legal
+        // move: anything makeMove refuses is an engine failure
+        Move move = ai.findBestMove(side);
+        if (!logic.makeMove(move)) return Outcome::Aborted;
+    }
+    return Outcome::Draw;
+}
+
+// One worker: a board, its rules and both engines, reused from one game to the next
+struct Worker {
+    Board board;
+    ChessLogic logic;
+    AIPlayer engineA;
+    AIPlayer engineB;
+
+    Worker(const EngineConfig& a, const EngineConfig& b)
+        : logic(board)
+        , engineA(board, logic)
+        , engineB(board, logic) {
+        configure(engineA, a);
+        configure(engineB, b);
+    }
+};
+
+// Results from the point of view of engine A
+struct Score {
+    int wins = 0;
+    int draws = 0;
+    int losses = 0;
+
+    int games() const { return wins + draws + losses; }
+    double ratio() const { return games() ? (wins + 0.5 * draws) / games() : 0.5; }
+};
+
+double eloFromScore(double score) {
+    score = std::min(std::max(score, 1e-6), 1.0 - 1e-6);
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+double scoreFromElo(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+// Variance of a single game's score (win 1, draw 1/2, loss 0)
+double scoreVariance(const Score& score) {
+    int n = score.games();
+    if (n == 0) return 0.0;
+    double w = static_cast<double>(score.wins) / n;
+    double d = static_cast<double>(score.draws) / n;
+    double l = static_cast<double>(score.losses) / n;
+    double s = score.ratio();
+    return w * (1.0 - s) * (1.0 - s) + d * (0.5 - s) * (0.5 - s) + l * s * s;
+}
+
+// 95% error margin of the Elo difference
+double eloMargin(const Score& score) {
+    int n = score.games();
+    if (n == 0) return 0.0;
+    double deviation = std::sqrt(scoreVariance(score) / n);
+    double s = score.ratio();
+    return (eloFromScore(s + 1.96 * deviation) - eloFromScore(s - 1.96 * deviation)) / 2.0;
+}
+
+// Log-likelihood ratio of H1 (elo1) against H0 (elo0), normal approximation
+// of the trinomial game results
+double logLikelihoodRatio(const Score& score, double elo0, double elo1) {
+    int n = score.games();
+    double variance = scoreVariance(score);
+    if (n == 0 || variance <= 0.0) return 0.0;
+    double s0 = scoreFromElo(elo0);
+    double s1 = scoreFromElo(elo1);
+    return (s1 - s0) * (2.0 * score.ratio() - s0 - s1) / (2.0 * variance / n);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    EngineConfig configA, configB;
+    int threads = 0;
+    int maxGames = 1000;
+    int plies = 8;
+    int maxPlies = 400;
+    double elo0 = 0.0, elo1 = 5.0;
+    double alpha = 0.05, beta = 0.05;
+    std::string openingsPath = "tools/openings.txt";
+
+    auto usage = [&] {
+        std::cerr << "Usage: " << argv[0] << " [-a spec] [-b spec] [-j threads] [-n games] [-o openings]"
+                  << " [-p plies] [-l maxplies] [-e elo0 elo1] [-r alpha beta]" << std::endl;
+        return 1;
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool hasPair = i + 2 < argc;
+        if (arg == "-a" && hasValue) {
+            if (!parseConfig(argv[++i], configA)) return usage();
+        } else if (arg == "-b" && hasValue) {
+            if (!parseConfig(argv[++i], configB)) return usage();
+        } else if (arg == "-j" && hasValue) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "-n" && hasValue) {
+            maxGames = std::atoi(argv[++i]);
+        } else if (arg == "-o" && hasValue) {
+            openingsPath = argv[++i];
+        } else if (arg == "-p" && hasValue) {
+            plies = std::atoi(argv[++i]);
+        } else if (arg == "-l" && hasValue) {
+            maxPlies = std::atoi(argv[++i]);
+        } else if (arg == "-e" && hasPair) {
+            elo0 = std::atof(argv[++i]);
+            elo1 = std::atof(argv[++i]);
+        } else if (arg == "-r" && hasPair) {
+            alpha = std::atof(argv[++i]);
+            beta = std::atof(argv[++i]);
+        } else {
+            return usage();
+        }
+    }
+
+    std::vector<Opening> openings;
+    if (!loadOpenings(openingsPath, plies, openings)) {
+        std::cerr << "Cannot read " << openingsPath << std::endl;
+        return 1;
+    }
+    if (openings.empty()) openings.push_back(Opening());
+    if (threads <= 0) threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    const double lowerBound = std::log(beta / (1.0 - alpha));
+    const double upperBound = std::log((1.0 - beta) / alpha);
+    std::cout << openings.size() << " openings, up to " << maxGames << " games on " << threads << " threads, SPRT elo0 "
+              << elo0 << " elo1 " << elo1 << " bounds [" << lowerBound << ", " << upperBound << "]" << std::endl;
+
+    // Pair k plays opening k, A first with white then with black
+    const int maxPairs = std::max(1, maxGames / 2);
+    std::atomic<int> nextPair{0};
+    std::atomic<bool> finished{false};
+    std::mutex resultMutex;
+    Score score;
+    int aborted = 0;
+    double llr = 0.0;
+
+    auto report = [&] {
+        char line[160];
+        std::snprintf(line, sizeof line, "Games %d: +%d =%d -%d  Elo %.1f +/- %.1f  LLR %.2f",
+                      score.games(), score.wins, score.draws, score.losses,
+                      eloFromScore(score.ratio()), eloMargin(score), llr);
+        std::cout << line << std::endl;
+    };
+
+    auto work = [&](Worker& worker) {
+        for (;;) {
+            int pair = nextPair.fetch_add(1);
+            if (pair >= maxPairs || finished) return;
+
+            const Opening& opening = openings[pair % openings.size()];
+            Outcome outcomes[2];
+            for (int game = 0; game < 2; ++game) {
+                bool aIsWhite = game == 0;
+                AIPlayer& white = aIsWhite ? worker.engineA : worker.engineB;
+                AIPlayer& black = aIsWhite ? worker.engineB : worker.engineA;
+                outcomes[game] = playGame(opening, white, black, worker.board, worker.logic, maxPlies);
+                if (outcomes[game] == Outcome::Aborted || finished) break;
+            }
+
+            std::lock_guard<std::mutex> lock(resultMutex);
+            if (finished) return;
+            if (outcomes[0] == Outcome::Aborted || outcomes[1] == Outcome::Aborted) {
+                aborted += 2;
+                continue;
+            }
+            for (int game = 0; game < 2; ++game) {
+                bool aIsWhite = game == 0;
+                if (outcomes[game] == Outcome::Draw) {
+                    ++score.draws;
+                } else if ((outcomes[game] == Outcome::WhiteWins) == aIsWhite) {
+                    ++score.wins;
+                } else {
+                    ++score.losses;
+                }
+            }
+
+            llr = logLikelihoodRatio(score, elo0, elo1);
+            if (score.games() % 10 == 0) report();
+            if (llr <= lowerBound || llr >= upperBound) finished = true;
+        }
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; ++i) {
+        workers.push_back(std::make_unique<Worker>(configA, configB));
+    }
+    for (auto& worker : workers) {
+        pool.emplace_back(work, std::ref(*worker));
+    }
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+
+    if (score.games() % 10 != 0) report();
+    if (aborted) {
+        std::cout << aborted << " games dropped with their pairs (illegal opening line or no move found)" << std::endl;
+    }
+    if (llr >= upperBound) {
+        std::cout << "H1 accepted: A is stronger than B by at least " << elo1 << " Elo" << std::endl;
+    } else if (llr <= lowerBound) {
+        std::cout << "H0 accepted: A is not stronger than B by " << elo1 << " Elo" << std::endl;
+    } else {
+        std::cout << "Inconclusive after " << score.games() << " games" << std::endl;
+    }
+    return 0;
+}
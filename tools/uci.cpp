@@ -0,0 +1,395 @@
+// Headless UCI front end for AIPlayer, without any SFML dependency.
+//
+//   ./chess-uci
+//
+// Supported commands: uci, isready, ucinewgame, setoption (Hash, Threads,
+// SyzygyPath, BookFile), position [startpos | fen <fen>] [moves ...],
+// go [movetime <ms>] [depth <n>] [wtime <ms>] [btime <ms>] [infinite] [ponder],
+// ponderhit, stop and quit. Each completed iteration prints an info line with
+// depth, score, nodes, nps, time and principal variation; the search replies
+// with bestmove (and the expected reply as ponder move). After "go infinite"
+// or "go ponder" bestmove is held back until "stop" (or "ponderhit" when
+// pondering), even if the search ends by itself.
+//
+//   ./chess-uci bench [depth]
+//
+// Searches a fixed suite of positions to a fixed depth (default BENCH_DEPTH)
+// on one thread, with an emptied hash table, no book, no tablebases and no
+// random choice among equal moves, then prints the total node count, time
+// and nps. The node count is a signature of the search: it only changes when
+// the search behaves differently. Also available as the "bench" command.
+
+#include "Board.hpp"
+#include "ChessLogic.hpp"
+#include "AIPlayer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Chess;
+
+namespace {
+
+const char* START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+// The search thread and the command loop both write to stdout
+std::mutex outputMutex;
+
+void send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::cout << line << std::endl;
+}
+
+// Openings, middlegames and endgames, a few with mates or promotions close by
+const char* BENCH_POSITIONS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 10",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 11",
+    "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+    "rq3rk1/ppp2ppp/1bnpb3/3N2B1/3NP3/7P/PPPQ1PP1/2KR3R w - - 7 14",
+    "r1bq1r1k/1pp1n1pp/1p1p4/4p2Q/4Pp2/1BNP4/PPP2PPP/3R1RK1 w - - 2 14",
+    "r3r1k1/2p2ppp/p1p1bn2/8/1q2P3/2NPQN2/PPP3PP/R4RK1 b - - 2 15",
+    "r1bbk1nr/pp3p1p/2n5/1N4p1/2Np1B2/8/PPP2PPP/2KR1B1R w kq - 0 13",
+    "r1bq1rk1/ppp1nppp/4n3/3p3Q/3P4/1BP1B3/PP1N2PP/R4RK1 w - - 1 16",
+    "4r1k1/r1q2ppp/ppp2n2/4P3/5Rb1/1N1BQ3/PPP3PP/R5K1 w - - 1 17",
+    "2rqkb1r/ppp2p2/2npb1p1/1N1Nn2p/2P1PP2/8/PP2B1PP/R1BQK2R b KQ - 0 11",
+    "r1bq1r1k/b1p1npp1/p2p3p/1p6/3PP3/1B2NN2/PP3PPP/R2Q1RK1 w - - 1 16",
+    "3r1rk1/p5pp/bpp1pp2/8/q1PP1P2/b3P3/P2NQRPP/1R2B1K1 b - - 6 22",
+    "r1q2rk1/2p1bppp/2Pp4/p6b/Q1PNp3/4B3/PP1R1PPP/2K4R w - - 2 18",
+    "4k2r/1pb2ppp/1p2p3/1R1p4/3P4/2r1PN2/P4PPP/1R4K1 b - - 3 22",
+    "3q2k1/pb3p1p/4pbp1/2r5/PpN2N2/1P2P2P/5PP1/Q2R2K1 b - - 4 26",
+    "6k1/6p1/6Pp/ppp5/3pn2P/1P3K2/1PP2P2/3N4 b - - 0 1",
+    "3b4/5kp1/1p1p1p1p/pP1PpP1P/P1P1P3/3KN3/8/8 w - - 0 1",
+    "2K5/p7/7P/5pR1/8/5k2/r7/8 w - - 0 1",
+    "8/6pk/1p6/8/PP3p1p/5P2/4KP1q/3Q4 w - - 0 1",
+    "7k/3p2pp/4q3/8/4Q3/5Kp1/P6b/8 w - - 0 1",
+    "8/2p5/8/2kPKp1p/2p4P/2P5/3P4/8 w - - 0 1",
+    "8/1p3pp1/7p/5P1P/2k3P1/8/2K2P2/8 w - - 0 1",
+    "8/pp2r1k1/2p1p3/3pP2p/1P1P1P1P/P5KR/8/8 w - - 0 1",
+    "8/3p4/p1bk3p/Pp6/1Kp1PpPp/2P2P1P/2P5/5B2 b - - 0 1",
+    "5k2/7R/4P2p/5K2/p1r2P1p/8/8/8 b - - 0 1",
+    "6k1/6p1/P6p/r1N5/5p2/7P/1b3PP1/4R1K1 w - - 0 1",
+    "1r3k2/4q3/2Pp3b/3Bp3/2Q2p2/1p1P2P1/1P2KP2/3N4 w - - 0 1",
+    "6k1/4pp1p/3p2p1/P1pPb3/R7/1r2P1PP/3B1P2/6K1 w - - 0 1",
+    "8/3p3B/5p2/5P2/p7/PP5b/k7/6K1 w - - 0 1",
+    "5rk1/q6p/2p3bR/1pPp1rP1/1P1Pp3/P3B1Q1/1K3P2/R7 w - - 93 90",
+    "4rrk1/1p1nq3/p7/2p1P1pp/3P2bp/3Q1Bn1/PPPB4/1K2R1NR w - - 40 21",
+    "r3k2r/3nnpbp/q2pp1p1/p7/Pp1PPPP1/4BNN1/1P5P/R2Q1RK1 w kq - 0 16",
+    "3Qb1k1/1r2ppb1/pN1n2q1/Pp1Pp1Pr/4P2p/4BP2/4B1R1/1R5K b - - 11 40",
+    "4k3/3q1r2/1N2r1b1/3ppN2/2nPP3/1B1R2n1/2R1Q3/3K4 w - - 5 1",
+    "8/8/8/8/5kp1/P7/8/1K1N4 w - - 0 1",
+    "8/8/8/5N2/8/p7/8/2NK3k w - - 0 1",
+    "8/3k4/8/8/8/4B3/4KB2/2B5 w - - 0 1",
+    "8/8/1P6/5pr1/8/4R3/7k/2K5 w - - 0 1",
+    "8/2p4P/8/kr6/6R1/8/8/1K6 w - - 0 1",
+    "8/8/3P3k/8/1p6/8/1P6/1K3n2 b - - 0 1",
+    "8/R7/2q5/8/6k1/8/1P5p/K6R w - - 0 124",
+    "6k1/3b3r/1p1p4/p1n2p2/1PPNpP1q/P3Q1p1/1R1RB1P1/5K2 b - - 0 1",
+    "r2r1n2/pp2bk2/2p1p2p/3q4/3PN1QP/2P3R1/P4PP1/5RK1 w - - 0 1",
+};
+
+const int BENCH_DEPTH = 8;
+
+std::string formatScore(int score) {
+    if (std::abs(score) > AIPlayer::MATE_SCORE - AIPlayer::MAX_PLY) {
+        int plies = AIPlayer::MATE_SCORE - std::abs(score);
+        int moves = (plies + 1) / 2;
+        return "mate " + std::to_string(score > 0 ? moves : -moves);
+    }
+    return "cp " + std::to_string(score);
+}
+
+std::string formatPv(const std::vector<Move>& pv) {
+    std::string text;
+    for (const Move& move : pv) {
+        text += ' ' + move.toUci();
+    }
+    return text;
+}
+
+void bench(int depth) {
+    Board board;
+    ChessLogic logic(board);
+    AIPlayer ai(board, logic);
+    ai.setDeterministic(true);
+    ai.setTablebasePieceLimit(0);
+    ai.setDepthLimit(depth);
+
+    std::uint64_t nodes = 0;
+    int count = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const char* fen : BENCH_POSITIONS) {
+        ++count;
+        logic.loadFEN(fen);
+        ai.clearHash();
+        Move best = ai.findBestMove(logic.getCurrentTurn());
+        const SearchStats& stats = ai.getLastSearchStats();
+        nodes += stats.nodes;
+        send("info string position " + std::to_string(count) + " bestmove " + best.toUci() +
+             " nodes " + std::to_string(stats.nodes));
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::uint64_t ms = static_cast<std::uint64_t>(elapsed.count());
+
+    send("===========================");
+    send("Positions       : " + std::to_string(count) + " at depth " + std::to_string(depth));
+    send("Total time (ms) : " + std::to_string(ms));
+    send("Nodes searched  : " + std::to_string(nodes));
+    send("Nodes/second    : " + std::to_string(ms > 0 ? nodes * 1000 / ms : nodes * 1000));
+}
+
+int benchDepth(std::istream& words) {
+    int depth = 0;
+    words >> depth;
+    return depth > 0 ? std::min(depth, AIPlayer::MAX_PLY - 1) : BENCH_DEPTH;
+}
+
+class UciEngine {
+public:
+    UciEngine()
+        : m_logic(m_board)
+        , m_ai(m_board, m_logic) {
+        m_board.initialize();
+        m_logic.reset();
+        m_ai.setDifficulty(AIDifficulty::Master);
+        m_ai.setIterationCallback([](const IterationStats& iteration, const std::vector<Move>& pv) {
+            std::uint64_t nps = iteration.elapsedMs > 0
+                ? iteration.nodes * 1000 / static_cast<std::uint64_t>(iteration.elapsedMs)
+                : iteration.nodes * 1000;
+            send("info depth " + std::to_string(iteration.depth) + " score " + formatScore(iteration.score) +
+                 " nodes " + std::to_string(iteration.nodes) + " nps " + std::to_string(nps) +
+                 " time " + std::to_string(iteration.elapsedMs) + " pv" + formatPv(pv));
+        });
+    }
+
+    ~UciEngine() { stop(); }
+
+    bool handle(const std::string& line) {
+        std::istringstream words(line);
+        std::string command;
+        words >> command;
+
+        if (command == "uci") {
+            send("id name ChessGame");
+            send("id author ChessGame contributors");
+            send("option name Hash type spin default " + std::to_string(TranspositionTable::DEFAULT_SIZE_MB) + " min 1 max 4096");
+            send("option name Threads type spin default 1 min 1 max 64");
+            send("option name SyzygyPath type string default <empty>");
+            send("option name BookFile type string default <empty>");
+            send("uciok");
+        } else if (command == "isready") {
+            send("readyok");
+        } else if (command == "ucinewgame") {
+            stop();
+            m_ai.clearHash();
+        } else if (command == "setoption") {
+            stop();
+            setOption(words);
+        } else if (command == "position") {
+            stop();
+            setPosition(words);
+        } else if (command == "go") {
+            stop();
+            go(words);
+        } else if (command == "bench") {
+            stop();
+            bench(benchDepth(words));
+        } else if (command == "ponderhit") {
+            ponderHit();
+        } else if (command == "stop") {
+            stop();
+        } else if (command == "quit") {
+            stop();
+            return false;
+        }
+        return true;
+    }
+
+private:
+    void setOption(std::istringstream& words) {
+        // setoption name <id> value <x>; names and values may contain spaces
+        std::string word, name, value;
+        std::string* field = nullptr;
+        while (words >> word) {
+            if (word == "name") {
+                field = &name;
+            } else if (word == "value") {
+                field = &value;
+            } else if (field) {
+                if (!field->empty()) *field += ' ';
+                *field += word;
+            }
+        }
+
+        if (name == "Hash") {
+            m_ai.setHashSize(static_cast<std::size_t>(std::max(1, std::atoi(value.c_str()))));
+        } else if (name == "Threads") {
+            m_ai.setThreadCount(std::atoi(value.c_str()));
+        } else if (name == "SyzygyPath") {
+            if (!value.empty() && value != "<empty>" && !m_ai.loadTablebases(value)) {
+                send("info string no tablebases found in " + value);
+            }
+        } else if (name == "BookFile") {
+            if (!value.empty() && value != "<empty>" && !m_ai.loadOpeningBook(value)) {
+                send("info string cannot open book " + value);
+            }
+        }
+    }
+
+    void setPosition(std::istringstream& words) {
+        std::string word;
+        words >> word;
+
+        std::string fen = START_FEN;
+        if (word == "fen") {
+            fen.clear();
+            while (words >> word && word != "moves") {
+                fen += fen.empty() ? word : ' ' + word;
+            }
+        } else {
+            words >> word;  // "moves", if any
+        }
+
+        if (!m_logic.loadFEN(fen)) {
+            send("info string invalid fen " + fen);
+            m_logic.loadFEN(START_FEN);
+            return;
+        }
+
+        while (words >> word) {
+            if (!playUci(word)) {
+                send("info string illegal move " + word);
+                break;
+            }
+        }
+    }
+
+    bool playUci(const std::string& uci) {
+        for (const Move& move : m_logic.getAllLegalMoves(m_logic.getCurrentTurn())) {
+            if (move.toUci() == uci) {
+                return m_logic.makeMove(move);
+            }
+        }
+        return false;
+    }
+
+    void go(std::istringstream& words) {
+        Color side = m_logic.getCurrentTurn();
+        int moveTime = 0;
+        int remaining = 0;
+        int depth = AIPlayer::MAX_PLY - 1;
+        bool infinite = false;
+        bool ponder = false;
+
+        std::string word;
+        while (words >> word) {
+            int value = 0;
+            if (word == "infinite") {
+                infinite = true;
+                continue;
+            }
+            if (word == "ponder") {
+                ponder = true;
+                continue;
+            }
+            if (!(words >> value)) break;
+            if (word == "movetime") {
+                moveTime = value;
+            } else if (word == "depth") {
+                depth = value;
+            } else if ((word == "wtime" && side == Color::White) || (word == "btime" && side == Color::Black)) {
+                remaining = value;
+            }
+        }
+
+        m_ai.setMoveTime(moveTime);
+        m_ai.setRemainingTime(remaining);
+        m_ai.setDepthLimit(depth);
+        {
+            std::lock_guard<std::mutex> lock(m_holdMutex);
+            m_infinite = infinite;
+            m_pondering = ponder;
+        }
+        // When pondering the clock only starts at "ponderhit", with the limits above
+        if (ponder) {
+            m_ai.startPondering(side);
+        } else {
+            m_ai.startSearch(side);
+        }
+
+        // The result is waited for off the command loop, which must keep reading "stop"
+        m_waiter = std::thread([this] {
+            Move best = m_ai.getSearchResult();
+            Move reply = m_ai.getExpectedReply();
+            {
+                // UCI forbids bestmove before "stop" or "ponderhit" in these modes
+                std::unique_lock<std::mutex> lock(m_holdMutex);
+                m_released.wait(lock, [this] { return !m_infinite && !m_pondering; });
+            }
+            // No legal move (null Move, from == to): UCI still expects an answer
+            bool found = best.from != best.to;
+            std::string answer = found ? best.toUci() : "0000";
+            if (found && reply.from != reply.to) {
+                answer += " ponder " + reply.toUci();
+            }
+            send("bestmove " + answer);
+        });
+    }
+
+    void ponderHit() {
+        std::lock_guard<std::mutex> lock(m_holdMutex);
+        if (!m_pondering) return;
+        m_ai.ponderHit();
+        m_pondering = false;
+        m_released.notify_all();
+    }
+
+    void stop() {
+        if (m_waiter.joinable()) {
+            m_ai.stopSearch();
+            {
+                std::lock_guard<std::mutex> lock(m_holdMutex);
+                m_infinite = false;
+                m_pondering = false;
+            }
+            m_released.notify_all();
+            m_waiter.join();
+        }
+    }
+
+    Board m_board;
+    ChessLogic m_logic;
+    AIPlayer m_ai;
+    std::thread m_waiter;
+
+    // Modes of the running "go": bestmove waits until both are cleared
+    std::mutex m_holdMutex;
+    std::condition_variable m_released;
+    bool m_infinite = false;
+    bool m_pondering = false;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::ios::sync_with_stdio(false);
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        std::istringstream words(argc > 2 ? argv[2] : "");
+        bench(benchDepth(words));
+        return 0;
+    }
+    
+    UciEngine engine;
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (!engine.handle(line)) break;
+    }
+    return 0;
+}